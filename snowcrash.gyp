@@ -32,6 +32,8 @@
         'sundown/src/html'
       ],
       'sources': [
+        'src/BlueprintArena.cc',
+        'src/BlueprintArena.h',
         'src/HTTP.cc',
         'src/MarkdownBlock.cc',
         'src/MarkdownParser.cc',
@@ -42,7 +44,16 @@
         'src/Serialize.h',
         'src/SerializeJSON.cc',
         'src/SerializeYAML.cc',
+        'src/SignatureLexer.cc',
+        'src/SignatureLexer.h',
+        'src/SignatureMemo.cc',
+        'src/SignatureMemo.h',
+        'src/SmallVector.h',
         'src/UriTemplateParser.cc',
+        'src/UTF8.cc',
+        'src/UTF8.h',
+        'src/WorkerThreads.h',
+        'src/Clock.h',
         'src/snowcrash.cc',
         'src/csnowcrash.cc',
         'src/CBlueprint.cc',
@@ -50,8 +61,8 @@
       ],
       'conditions': [
         [ 'OS=="win"', 
-          { 'sources': [ 'src/win/RegexMatch.cc' ] }, 
-          { 'sources': [ 'src/posix/RegexMatch.cc' ] } # OS != Windows
+          { 'sources': [ 'src/win/RegexMatch.cc', 'src/win/WorkerThreads.cc', 'src/win/Clock.cc' ] }, 
+          { 'sources': [ 'src/posix/RegexMatch.cc', 'src/posix/WorkerThreads.cc', 'src/posix/Clock.cc' ] } # OS != Windows
         ]
       ],
       'dependencies': [
@@ -72,6 +83,7 @@
         'test/test-ActionParser.cc',
         'test/test-AssetParser.cc',
         'test/test-Blueprint.cc',
+        'test/test-BlueprintArena.cc',
         'test/test-BlueprintParser.cc',
         'test/test-HeaderParser.cc',
         'test/test-Indentation.cc',
@@ -85,11 +97,15 @@
         'test/test-RegexMatch.cc',
         'test/test-ResouceGroupParser.cc',
         'test/test-ResourceParser.cc',
+        'test/test-SignatureLexer.cc',
+        'test/test-SignatureMemo.cc',
+        'test/test-SmallVector.cc',
         'test/test-SymbolIdentifier.cc',
         'test/test-SymbolTable.cc',
         'test/test-Warnings.cc',
         'test/test-csnowcrash.cc',
         'test/test-UriTemplateParser.cc',
+        'test/test-UTF8.cc',
         'test/test-snowcrash.cc'
       ],
       'dependencies': [
@@ -134,6 +150,107 @@
             'libsnowcrash',
             'sundown'
           ]
+        },
+        {
+          'target_name': 'perf-signature',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-signature.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
+        },
+        {
+          'target_name': 'perf-context',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-context.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
+        },
+        {
+          'target_name': 'perf-utf8',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-utf8.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash'
+          ]
+        },
+        {
+          'target_name': 'perf-models',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-models.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
+        },
+        {
+          'target_name': 'perf-scaling',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-scaling.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
+        },
+        {
+          'target_name': 'perf-arena',
+          'type': 'executable',
+          'include_dirs': [
+            'src',
+            'cmdline',
+            'test',
+            'test/performance',
+          ],
+          'sources': [
+            'test/performance/perf-arena.cc'
+          ],
+          'dependencies': [
+            'libsnowcrash',
+            'sundown'
+          ]
         }
       ]
     }]
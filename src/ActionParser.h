@@ -12,6 +12,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "PayloadParser.h"
 #include "HeaderParser.h"
 #include "ParametersParser.h"
@@ -46,18 +47,17 @@ namespace snowcrash {
             block.content.empty())
             return NoActionSignature;
         
-        CaptureGroups captureGroups;
-        if (RegexCapture(block.content, snowcrashconst::ActionHeaderRegex, captureGroups, 3)) {
+        SignatureToken nameToken, methodToken, uriToken;
+        if (LexActionHeader(block.content.data(), block.content.length(), methodToken, uriToken)) {
             // Nameless action
-            method = captureGroups[1];
-            URITemplate uri = captureGroups[2];
-            return (uri.empty()) ? MethodActionSignature : MethodURIActionSignature;
+            method = SignatureTokenString(block.content.data(), methodToken);
+            return (uriToken.length == 0) ? MethodActionSignature : MethodURIActionSignature;
         }
-        else if (RegexCapture(block.content, snowcrashconst::NamedActionHeaderRegex, captureGroups, 3)) {
+        else if (LexNamedActionHeader(block.content.data(), block.content.length(), nameToken, methodToken)) {
             // Named action
-            name = captureGroups[1];
+            name = SignatureTokenString(block.content.data(), nameToken);
             TrimString(name);
-            method = captureGroups[2];
+            method = SignatureTokenString(block.content.data(), methodToken);
             return NamedActionSignature;
         }
         
@@ -71,9 +71,14 @@ namespace snowcrash {
             block.content.empty())
             return false;
         
+        int memo = SignatureMemo::Lookup(block, SignatureMemo::ActionEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
+        
         Name name;
         HTTPMethod method;
-        return GetActionSignature(block, name, method) != NoActionSignature;
+        bool signature = GetActionSignature(block, name, method) != NoActionSignature;
+        return SignatureMemo::Store(block, SignatureMemo::ActionEntry, signature) != 0;
     }
     
     // Finds an action inside resource
@@ -81,7 +86,7 @@ namespace snowcrash {
                                                         const Action& action) {
         return std::find_if(resource.actions.begin(),
                             resource.actions.end(),
-                            std::bind2nd(MatchAction<Action>(), action));
+                            std::bind(MatchAction<Action>(), std::placeholders::_1, std::cref(action)));
     }
     
     //
@@ -96,9 +101,7 @@ namespace snowcrash {
         if (HasParametersSignature(begin, end))
             return ParametersSectionType;
         
-        Name name;
-        SourceData mediaType;
-        PayloadSignature payload = GetPayloadSignature(begin, end, name, mediaType);
+        PayloadSignature payload = QueryPayloadSignature(begin, end);
         if (payload == RequestPayloadSignature)
             return RequestSectionType;
         else if (payload == ResponsePayloadSignature)
@@ -271,7 +274,7 @@ namespace snowcrash {
             
             result = ParseDescriptionBlock<Action>(section,
                                                     sectionCur,
-                                                    parser.sourceData,
+                                                    parser,
                                                     action);
             return result;
         }
@@ -298,7 +301,9 @@ namespace snowcrash {
                                                         sourceBlock));
             }
             else {
-                action.parameters.insert(action.parameters.end(), parameters.begin(), parameters.end());
+                action.parameters.insert(action.parameters.end(),
+                                         std::make_move_iterator(parameters.begin()),
+                                         std::make_move_iterator(parameters.end()));
             }
             
             return result;
@@ -318,6 +323,7 @@ namespace snowcrash {
                                                 Action& action)
         {
             Payload payload;
+            size_t forwardReferences = parser.symbolTable.forwardReferences.size();
             ParseSectionResult result = PayloadParser::Parse(cur,
                                                              section.bounds.second,
                                                              section,
@@ -353,20 +359,26 @@ namespace snowcrash {
                                                         sourceBlock));
             }
 
-            // Check payload integrity
-            CheckPayload(section.type, payload, action.method, nameBlock->sourceMap, parser.sourceData, result.first);
+            // Check payload integrity, once resolved if it refers to a model defined later
+            if (parser.symbolTable.forwardReferences.size() == forwardReferences) {
+                CheckPayload(section.type, payload, action.method, nameBlock->sourceMap, parser.sourceData, result.first);
+            }
+            else {
+                DeferredPayloadCheck check = { section.type, action.method, nameBlock->sourceMap };
+                parser.deferredPayloadChecks.push_back(check);
+            }
+            
+            // Check header duplicates
+            CheckHeaderDuplicates(action, payload, nameBlock->sourceMap, parser.sourceData, result.first);
             
             // Inject parsed payload into the action
             if (section.type == RequestSectionType) {
-                action.examples.back().requests.push_back(payload);
+                action.examples.back().requests.push_back(std::move(payload));
             }
             else if (section.type == ResponseSectionType) {
-                action.examples.back().responses.push_back(payload);
+                action.examples.back().responses.push_back(std::move(payload));
             }
             
-            // Check header duplicates
-            CheckHeaderDuplicates(action, payload, nameBlock->sourceMap, parser.sourceData, result.first);
-            
             return result;
         }
         
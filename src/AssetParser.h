@@ -13,6 +13,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "StringUtility.h"
 #include "SectionUtility.h"
 
@@ -43,23 +44,25 @@ namespace snowcrash {
         
         if (begin->type == ListBlockBeginType || begin->type == ListItemBlockBeginType) {
             
-            BlockIterator cur = ListItemNameBlock(begin, end);
-            if (cur == end)
-                return NoAssetSignature;
-            
-            if (cur->type != ParagraphBlockType &&
-                cur->type != ListItemBlockEndType)
-                return NoAssetSignature;
+            int memo = SignatureMemo::Lookup(*begin, SignatureMemo::AssetEntry);
+            if (memo != SignatureMemo::Unknown)
+                return static_cast<AssetSignature>(memo);
             
-            std::string content = GetFirstLine(cur->content);
-            if (RegexMatch(content, snowcrashconst::BodyRegex))
-                return BodyAssetSignature;
-
-            if (RegexMatch(content, snowcrashconst::SchemaRegex))
-                return SchemaAssetSignature;
+            AssetSignature signature = NoAssetSignature;
+            BlockIterator cur = ListItemNameBlock(begin, end);
+            if (cur != end &&
+                (cur->type == ParagraphBlockType || cur->type == ListItemBlockEndType)) {
+                
+                MarkdownBlock::Content content = GetFirstLine(cur->content);
+                if (LexKeywordSignature(content.data(), content.length(), "body"))
+                    signature = BodyAssetSignature;
+                else if (LexKeywordSignature(content.data(), content.length(), "schema"))
+                    signature = SchemaAssetSignature;
+                else if (HasPayloadAssetSignature(begin, end))
+                    signature = PayloadBodyAssetSignature;
+            }
             
-            if (HasPayloadAssetSignature(begin, end))
-                return PayloadBodyAssetSignature;
+            return static_cast<AssetSignature>(SignatureMemo::Store(*begin, SignatureMemo::AssetEntry, signature));
         }
         
         return NoAssetSignature;
@@ -192,6 +195,15 @@ namespace snowcrash {
                 parser.sourceData.empty())
                 return result;
             
+            // Only an asset being defined matters when validating, its size is spent nevertheless
+            parser.budget.spendASTBytes(data.length());
+            if (parser.options & ValidateOnlyOption) {
+                if (asset.empty())
+                    asset.assign(data, 0, 1);
+                
+                return result;
+            }
+            
             asset += data;
             return result;
         }
@@ -23,7 +23,8 @@ namespace snowcrash {
      *  \return An iterator pointing to the end of the section.
      *
      *  Advances iterator from the begin of a section to the end
-     *  of a section at the same nesting level.
+     *  of a section at the same nesting level. Takes constant time
+     *  for blocks matched by the markdown parser or %MatchClosingBlocks().
      */
     FORCEINLINE BlockIterator SkipToClosingBlock(const BlockIterator& begin,
                                                  const BlockIterator& end,
@@ -32,6 +33,15 @@ namespace snowcrash {
         
         BlockIterator currentBlock = begin;
         if (currentBlock->type == sectionBegin) {
+            
+            // Closing block matched by the markdown parser
+            if (currentBlock->closingOffset && sectionEnd == ClosingBlockType(sectionBegin)) {
+                if (currentBlock->closingOffset < end - begin)
+                    return begin + currentBlock->closingOffset;
+                
+                return end;
+            }
+            
             int level = 1;
             ++currentBlock;
             while (currentBlock != end && level) {
@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <utility>
 #include "Platform.h"
 
@@ -67,6 +68,97 @@ namespace snowcrash {
     /** An asset data */
     typedef std::string Asset;
 
+    /** An empty asset, the data of an empty %SharedAsset */
+    extern const Asset EmptyAsset;
+
+    /**
+     *  \brief  An immutable asset shared by its copies.
+     *
+     *  Copying a payload copies only a reference to its body and schema.
+     *  A resource model referred by many payloads holds its assets once
+     *  no matter how many payloads refer to it.
+     *
+     *  Converts implicitly to `const std::string&` and provides the read
+     *  access of `std::string`. Appending replaces the asset with a new
+     *  one, the payloads sharing the previous asset are not modified.
+     *
+     *  \note  Prior to the sharing, %Payload::body and %Payload::schema
+     *          were plain `std::string`s. Code taking a non-const reference
+     *          to them, e.g. `std::string& body = payload.body;`, no longer
+     *          compiles; copy the asset with %str(), modify the copy and
+     *          assign it back.
+     */
+    class SharedAsset {
+    public:
+        typedef Asset::size_type size_type;
+        typedef Asset::const_iterator const_iterator;
+
+        SharedAsset() {}
+        SharedAsset(const Asset& asset) { assign(Asset(asset)); }
+        SharedAsset(Asset&& asset) { assign(std::move(asset)); }
+        SharedAsset(const char* asset) { assign(Asset(asset)); }
+
+        SharedAsset& operator=(const Asset& asset) { assign(Asset(asset)); return *this; }
+        SharedAsset& operator=(Asset&& asset) { assign(std::move(asset)); return *this; }
+        SharedAsset& operator=(const char* asset) { assign(Asset(asset)); return *this; }
+
+        /** \return The asset */
+        const Asset& str() const { return (m_asset) ? *m_asset : EmptyAsset; }
+        operator const Asset&() const { return str(); }
+
+        bool empty() const { return !m_asset; }
+        size_type length() const { return str().length(); }
+        size_type size() const { return str().size(); }
+        const char* c_str() const { return str().c_str(); }
+        const char* data() const { return str().data(); }
+        char operator[](size_type pos) const { return str()[pos]; }
+
+        const_iterator begin() const { return str().begin(); }
+        const_iterator end() const { return str().end(); }
+
+        size_type find(const Asset& s, size_type pos = 0) const { return str().find(s, pos); }
+        size_type find(char c, size_type pos = 0) const { return str().find(c, pos); }
+        Asset substr(size_type pos = 0, size_type n = Asset::npos) const { return str().substr(pos, n); }
+        int compare(const Asset& s) const { return str().compare(s); }
+
+        void clear() { m_asset.reset(); }
+
+        /** Append to the asset, the copies sharing the asset keep the previous one */
+        SharedAsset& append(const Asset& s) {
+            if (!s.empty())
+                assign(str() + s);
+            return *this;
+        }
+
+        SharedAsset& operator+=(const Asset& s) { return append(s); }
+
+        /** \return True if both assets share the same data */
+        bool sharedWith(const SharedAsset& rhs) const { return m_asset && m_asset == rhs.m_asset; }
+
+    private:
+        std::shared_ptr<const Asset> m_asset;
+
+        void assign(Asset&& asset) {
+            if (asset.empty())
+                m_asset.reset();
+            else
+                m_asset = std::make_shared<const Asset>(std::move(asset));
+        }
+    };
+
+    inline bool operator==(const SharedAsset& lhs, const SharedAsset& rhs) {
+        return lhs.sharedWith(rhs) || lhs.str() == rhs.str();
+    }
+
+    inline bool operator==(const SharedAsset& lhs, const Asset& rhs) { return lhs.str() == rhs; }
+    inline bool operator==(const Asset& lhs, const SharedAsset& rhs) { return lhs == rhs.str(); }
+    inline bool operator==(const SharedAsset& lhs, const char* rhs) { return lhs.str() == rhs; }
+
+    inline bool operator!=(const SharedAsset& lhs, const SharedAsset& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const SharedAsset& lhs, const Asset& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const Asset& lhs, const SharedAsset& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const SharedAsset& lhs, const char* rhs) { return !(lhs == rhs); }
+
     /** 
      *  \brief Metadata key-value pair,
      *
@@ -131,11 +223,21 @@ namespace snowcrash {
         /** Payload-specific Headers */
         Collection<Header>::type headers;
         
-        /** Body */
-        Asset body;
+        /** Body, shared with the model the payload refers to */
+        SharedAsset body;
+        
+        /** Schema, shared with the model the payload refers to */
+        SharedAsset schema;
         
-        /** Schema */
-        Asset schema;
+        /** 
+         *  \brief Name of the Resource Model the payload refers to
+         *
+         *  Empty unless the payload is a reference to a model. The model's
+         *  description, body and schema are resolved into the payload
+         *  once the whole blueprint is parsed, the body and schema are
+         *  shared with the model rather than copied.
+         */
+        Name reference;
     };
     
     /** Resource Model */
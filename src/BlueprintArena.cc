@@ -0,0 +1,372 @@
+//
+//  BlueprintArena.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include "BlueprintArena.h"
+#include "StringUtility.h"
+
+using namespace snowcrash;
+
+/** Distance behind the previously found string a string is looked up in the source (bytes) */
+static const size_t SourceLookBehind = 256;
+
+/** Distance past the previously found string a string is looked up in the source (bytes) */
+static const size_t SourceLookAhead = 4096;
+
+Arena::Arena(size_t chunkSize)
+: m_cursor(NULL), m_available(0), m_chunkSize(chunkSize), m_size(0), m_capacity(0)
+{
+}
+
+Arena::~Arena()
+{
+    clear();
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - reinterpret_cast<size_t>(m_cursor) % alignment) % alignment;
+
+    if (padding + size > m_available) {
+
+        // Large requests get a chunk of their own, the current chunk is kept
+        if (size > m_chunkSize / 4) {
+            char* chunk = new char[size];
+            m_chunks.push_back(chunk);
+            m_size += size;
+            m_capacity += size;
+            return chunk;
+        }
+
+        m_cursor = new char[m_chunkSize];
+        m_chunks.push_back(m_cursor);
+        m_available = m_chunkSize;
+        m_capacity += m_chunkSize;
+        padding = 0;
+    }
+
+    char* memory = m_cursor + padding;
+    m_cursor = memory + size;
+    m_available -= padding + size;
+    m_size += size;
+    return memory;
+}
+
+void Arena::clear()
+{
+    for (std::vector<char*>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        delete [] *it;
+
+    m_chunks.clear();
+    m_cursor = NULL;
+    m_available = 0;
+    m_size = 0;
+    m_capacity = 0;
+}
+
+namespace {
+
+    /** \return First occurrence of a string in a range, NULL if not found */
+    const char* Find(const char* begin, const char* end, const std::string& value) {
+        
+        // Candidates are located by the first byte
+        const char* cur = begin;
+        while (static_cast<size_t>(end - cur) >= value.length()) {
+            cur = static_cast<const char*>(::memchr(cur, value[0], end - cur - value.length() + 1));
+            if (!cur)
+                return NULL;
+
+            if (::memcmp(cur, value.data(), value.length()) == 0)
+                return cur;
+
+            ++cur;
+        }
+
+        return NULL;
+    }
+
+    /** FNV-1a hash of the bytes of a slice */
+    struct StringSliceHash {
+        size_t operator()(const StringSlice& slice) const {
+            return HashString(slice.data, slice.length);
+        }
+    };
+
+    /** Equality of the bytes of slices */
+    struct StringSliceEqual {
+        bool operator()(const StringSlice& lhs, const StringSlice& rhs) const {
+            return lhs.length == rhs.length && ::memcmp(lhs.data, rhs.data, lhs.length) == 0;
+        }
+    };
+
+    /** Strings interned in an arena */
+    typedef std::unordered_set<StringSlice, StringSliceHash, StringSliceEqual> InternedStrings;
+
+    /**
+     *  \brief  Builder of the arena AST nodes.
+     *
+     *  Nodes are built in the order of the %Blueprint fields, which
+     *  follows the order of the source closely enough for a string to
+     *  be looked up near the previously found one.
+     */
+    class ArenaBuilder {
+    public:
+        ArenaBuilder(Arena& arena, const char* source, size_t length)
+        : m_arena(arena), m_source(source), m_length(length), m_cursor(0), m_slicedLength(0) {}
+
+        /** \return Number of string bytes pointing into the source */
+        size_t slicedLength() const { return m_slicedLength; }
+
+        /** \return Number of distinct strings interned in the arena */
+        size_t internedCount() const { return m_interned.size(); }
+
+        void build(const std::string& value, StringSlice& slice) {
+            slice.data = NULL;
+            slice.length = value.length();
+            if (value.empty())
+                return;
+
+            if (m_length) {
+                size_t begin = (m_cursor > SourceLookBehind) ? m_cursor - SourceLookBehind : 0;
+                size_t end = std::min(m_length, m_cursor + value.length() + SourceLookAhead);
+                const char* match = Find(m_source + begin, m_source + end, value);
+
+                if (match) {
+                    slice.data = match;
+                    m_cursor = (match - m_source) + value.length();
+                    m_slicedLength += value.length();
+                    return;
+                }
+            }
+
+            // Not in the source, share the copy of an equal string
+            slice.data = value.data();
+            InternedStrings::const_iterator it = m_interned.find(slice);
+            if (it != m_interned.end()) {
+                slice.data = it->data;
+                return;
+            }
+
+            char* copy = static_cast<char*>(m_arena.allocate(value.length(), 1));
+            ::memcpy(copy, value.data(), value.length());
+            slice.data = copy;
+            m_interned.insert(slice);
+        }
+
+        void build(const KeyValuePair& pair, ArenaKeyValuePair& node) {
+            build(pair.first, node.first);
+            build(pair.second, node.second);
+        }
+
+        void build(const Parameter& parameter, ArenaParameter& node) {
+            build(parameter.name, node.name);
+            build(parameter.description, node.description);
+            build(parameter.type, node.type);
+            node.use = parameter.use;
+            build(parameter.defaultValue, node.defaultValue);
+            build(parameter.exampleValue, node.exampleValue);
+            build(parameter.values, node.values);
+        }
+
+        void build(const Payload& payload, ArenaPayload& node) {
+            build(payload.name, node.name);
+            build(payload.description, node.description);
+            build(payload.parameters, node.parameters);
+            build(payload.headers, node.headers);
+            build(payload.body, node.body);
+            build(payload.schema, node.schema);
+            build(payload.reference, node.reference);
+        }
+
+        void build(const TransactionExample& example, ArenaTransactionExample& node) {
+            build(example.name, node.name);
+            build(example.description, node.description);
+            build(example.requests, node.requests);
+            build(example.responses, node.responses);
+        }
+
+        void build(const Action& action, ArenaAction& node) {
+            build(action.method, node.method);
+            build(action.name, node.name);
+            build(action.description, node.description);
+            build(action.parameters, node.parameters);
+            build(action.headers, node.headers);
+            build(action.examples, node.examples);
+        }
+
+        void build(const Resource& resource, ArenaResource& node) {
+            build(resource.uriTemplate, node.uriTemplate);
+            build(resource.name, node.name);
+            build(resource.description, node.description);
+            build(resource.model, node.model);
+            build(resource.parameters, node.parameters);
+            build(resource.headers, node.headers);
+            build(resource.actions, node.actions);
+        }
+
+        void build(const ResourceGroup& group, ArenaResourceGroup& node) {
+            build(group.name, node.name);
+            build(group.description, node.description);
+            build(group.resources, node.resources);
+        }
+
+        void build(const Blueprint& blueprint, ArenaBlueprint& node) {
+            build(blueprint.metadata, node.metadata);
+            build(blueprint.name, node.name);
+            build(blueprint.description, node.description);
+            build(blueprint.resourceGroups, node.resourceGroups);
+        }
+
+        template <typename T, typename N>
+        void build(const std::vector<T>& values, ArenaArray<N>& array) {
+            array.data = NULL;
+            array.count = values.size();
+            if (values.empty())
+                return;
+
+            N* nodes = static_cast<N*>(m_arena.allocate(values.size() * sizeof(N)));
+            for (size_t i = 0; i < values.size(); ++i)
+                build(values[i], nodes[i]);
+
+            array.data = nodes;
+        }
+
+    private:
+        Arena& m_arena;
+        const char* m_source;
+        size_t m_length;
+        size_t m_cursor;
+        size_t m_slicedLength;
+        InternedStrings m_interned;
+    };
+
+    void Materialize(const StringSlice& slice, std::string& value) {
+        if (slice.length)
+            value.assign(slice.data, slice.length);
+        else
+            value.clear();
+    }
+
+    void Materialize(const StringSlice& slice, SharedAsset& asset) {
+        asset = slice.str();
+    }
+
+    void Materialize(const ArenaKeyValuePair& node, KeyValuePair& pair) {
+        Materialize(node.first, pair.first);
+        Materialize(node.second, pair.second);
+    }
+
+    template <typename N, typename T>
+    void Materialize(const ArenaArray<N>& array, std::vector<T>& values);
+
+    void Materialize(const ArenaParameter& node, Parameter& parameter) {
+        Materialize(node.name, parameter.name);
+        Materialize(node.description, parameter.description);
+        Materialize(node.type, parameter.type);
+        parameter.use = node.use;
+        Materialize(node.defaultValue, parameter.defaultValue);
+        Materialize(node.exampleValue, parameter.exampleValue);
+        Materialize(node.values, parameter.values);
+    }
+
+    void Materialize(const ArenaPayload& node, Payload& payload) {
+        Materialize(node.name, payload.name);
+        Materialize(node.description, payload.description);
+        Materialize(node.parameters, payload.parameters);
+        Materialize(node.headers, payload.headers);
+        Materialize(node.body, payload.body);
+        Materialize(node.schema, payload.schema);
+        Materialize(node.reference, payload.reference);
+    }
+
+    void Materialize(const ArenaTransactionExample& node, TransactionExample& example) {
+        Materialize(node.name, example.name);
+        Materialize(node.description, example.description);
+        Materialize(node.requests, example.requests);
+        Materialize(node.responses, example.responses);
+    }
+
+    void Materialize(const ArenaAction& node, Action& action) {
+        Materialize(node.method, action.method);
+        Materialize(node.name, action.name);
+        Materialize(node.description, action.description);
+        Materialize(node.parameters, action.parameters);
+        Materialize(node.headers, action.headers);
+        Materialize(node.examples, action.examples);
+    }
+
+    void Materialize(const ArenaResource& node, Resource& resource) {
+        Materialize(node.uriTemplate, resource.uriTemplate);
+        Materialize(node.name, resource.name);
+        Materialize(node.description, resource.description);
+        Materialize(node.model, resource.model);
+        Materialize(node.parameters, resource.parameters);
+        Materialize(node.headers, resource.headers);
+        Materialize(node.actions, resource.actions);
+    }
+
+    void Materialize(const ArenaResourceGroup& node, ResourceGroup& group) {
+        Materialize(node.name, group.name);
+        Materialize(node.description, group.description);
+        Materialize(node.resources, group.resources);
+    }
+
+    template <typename N, typename T>
+    void Materialize(const ArenaArray<N>& array, std::vector<T>& values) {
+        values.clear();
+        values.resize(array.size());
+        for (size_t i = 0; i < array.size(); ++i)
+            Materialize(array[i], values[i]);
+    }
+}
+
+BlueprintArena::BlueprintArena()
+: m_slicedLength(0), m_internedCount(0)
+{
+    clear();
+}
+
+BlueprintArena::BlueprintArena(const Blueprint& blueprint, const SourceData& source)
+: m_slicedLength(0), m_internedCount(0)
+{
+    assign(blueprint, source);
+}
+
+void BlueprintArena::assign(const Blueprint& blueprint, const SourceData& source)
+{
+    clear();
+
+    // Retain the source
+    char* retained = NULL;
+    if (!source.empty()) {
+        retained = static_cast<char*>(m_arena.allocate(source.length(), 1));
+        ::memcpy(retained, source.data(), source.length());
+    }
+
+    ArenaBuilder builder(m_arena, retained, source.length());
+    builder.build(blueprint, m_blueprint);
+    m_slicedLength = builder.slicedLength();
+    m_internedCount = builder.internedCount();
+}
+
+void BlueprintArena::clear()
+{
+    m_arena.clear();
+    ::memset(&m_blueprint, 0, sizeof(m_blueprint));
+    m_slicedLength = 0;
+    m_internedCount = 0;
+}
+
+void BlueprintArena::materialize(Blueprint& blueprint) const
+{
+    Materialize(m_blueprint.metadata, blueprint.metadata);
+    Materialize(m_blueprint.name, blueprint.name);
+    Materialize(m_blueprint.description, blueprint.description);
+    Materialize(m_blueprint.resourceGroups, blueprint.resourceGroups);
+}
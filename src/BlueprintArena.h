@@ -0,0 +1,244 @@
+//
+//  BlueprintArena.h
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#ifndef SNOWCRASH_BLUEPRINTARENA_H
+#define SNOWCRASH_BLUEPRINTARENA_H
+
+#include <vector>
+#include <string>
+#include "Blueprint.h"
+#include "ParserCore.h"
+
+namespace snowcrash {
+
+    /**
+     *  \brief  Chunked bump allocator.
+     *
+     *  Memory is handed out of large chunks and released all at once
+     *  when the arena is cleared or destroyed. Objects placed in the
+     *  arena are never destructed, they must be plain-old-data.
+     */
+    class Arena {
+    public:
+
+        /** Default size of a chunk (bytes) */
+        static const size_t DefaultChunkSize = 64 * 1024;
+
+        /** Alignment of the memory handed out by %allocate() */
+        static const size_t Alignment = (sizeof(double) > sizeof(void*)) ? sizeof(double) : sizeof(void*);
+
+        explicit Arena(size_t chunkSize = DefaultChunkSize);
+        ~Arena();
+
+        /**
+         *  \brief  Allocate memory.
+         *  \param  size        Number of bytes to allocate.
+         *  \param  alignment   Alignment of the memory, a power of two
+         *                      not greater than %Alignment.
+         *
+         *  Requests larger than a quarter of the chunk size not fitting
+         *  the current chunk get a chunk of their own.
+         */
+        void* allocate(size_t size, size_t alignment = Alignment);
+
+        /** Release all the memory */
+        void clear();
+
+        /** \return Number of bytes handed out */
+        size_t size() const { return m_size; }
+
+        /** \return Number of bytes held in chunks */
+        size_t capacity() const { return m_capacity; }
+
+        /** \return Number of chunks */
+        size_t chunks() const { return m_chunks.size(); }
+
+    private:
+        std::vector<char*> m_chunks;
+        char* m_cursor;
+        size_t m_available;
+        size_t m_chunkSize;
+        size_t m_size;
+        size_t m_capacity;
+
+        Arena(const Arena&);
+        Arena& operator=(const Arena&);
+    };
+
+    /**
+     *  \brief  Slice of a string held by a retained source or an arena.
+     */
+    struct StringSlice {
+        const char* data;   /// < First byte of the string, not NUL-terminated
+        size_t length;      /// < Length of the string in bytes
+
+        bool empty() const { return length == 0; }
+
+        /** \return The slice as a string */
+        std::string str() const { return (length) ? std::string(data, length) : std::string(); }
+    };
+
+    /**
+     *  \brief  Array of plain-old-data elements held by an arena.
+     */
+    template <typename T>
+    struct ArenaArray {
+        typedef const T* const_iterator;
+
+        const T* data;      /// < First element
+        size_t count;       /// < Number of elements
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        const_iterator begin() const { return data; }
+        const_iterator end() const { return data + count; }
+
+        const T& operator[](size_t index) const { return data[index]; }
+    };
+
+    /** Key-value pair, see %KeyValuePair */
+    struct ArenaKeyValuePair {
+        StringSlice first;
+        StringSlice second;
+    };
+
+    /** Parameter, see %Parameter */
+    struct ArenaParameter {
+        StringSlice name;
+        StringSlice description;
+        StringSlice type;
+        ParameterUse use;
+        StringSlice defaultValue;
+        StringSlice exampleValue;
+        ArenaArray<StringSlice> values;
+    };
+
+    /** Payload, see %Payload */
+    struct ArenaPayload {
+        StringSlice name;
+        StringSlice description;
+        ArenaArray<ArenaParameter> parameters;
+        ArenaArray<ArenaKeyValuePair> headers;
+        StringSlice body;
+        StringSlice schema;
+        StringSlice reference;
+    };
+
+    /** Transaction example, see %TransactionExample */
+    struct ArenaTransactionExample {
+        StringSlice name;
+        StringSlice description;
+        ArenaArray<ArenaPayload> requests;
+        ArenaArray<ArenaPayload> responses;
+    };
+
+    /** Action, see %Action */
+    struct ArenaAction {
+        StringSlice method;
+        StringSlice name;
+        StringSlice description;
+        ArenaArray<ArenaParameter> parameters;
+        DEPRECATED ArenaArray<ArenaKeyValuePair> headers;
+        ArenaArray<ArenaTransactionExample> examples;
+    };
+
+    /** Resource, see %Resource */
+    struct ArenaResource {
+        StringSlice uriTemplate;
+        StringSlice name;
+        StringSlice description;
+        ArenaPayload model;
+        ArenaArray<ArenaParameter> parameters;
+        DEPRECATED ArenaArray<ArenaKeyValuePair> headers;
+        ArenaArray<ArenaAction> actions;
+    };
+
+    /** Resource group, see %ResourceGroup */
+    struct ArenaResourceGroup {
+        StringSlice name;
+        StringSlice description;
+        ArenaArray<ArenaResource> resources;
+    };
+
+    /** Blueprint, see %Blueprint */
+    struct ArenaBlueprint {
+        ArenaArray<ArenaKeyValuePair> metadata;
+        StringSlice name;
+        StringSlice description;
+        ArenaArray<ArenaResourceGroup> resourceGroups;
+    };
+
+    /**
+     *  \brief  Blueprint AST held by a per-document arena.
+     *
+     *  An alternative to %Blueprint for documents kept around after
+     *  parsing, such as cached ASTs. The whole AST, including its
+     *  strings, lives in a few arena chunks, it is built and released
+     *  at the cost of a handful of allocations regardless of its size.
+     *
+     *  The source of the blueprint is retained in the arena. Strings
+     *  found verbatim in the source near the previously found string
+     *  point into the retained source, other strings (e.g. rendered
+     *  descriptions, assets stripped of indentation or headers added
+     *  by the parser) are interned in the arena, a value repeated
+     *  across the document is copied once and its slices share it.
+     *
+     *  The arena is built out of a parsed %Blueprint, the strings are
+     *  interned once the parse is done rather than while parsing, the
+     *  peak memory of a parse is that of the %Blueprint. The retained
+     *  source counts towards the memory held by the arena.
+     *
+     *  Use %materialize() to convert the AST to a %Blueprint. The
+     *  nodes are valid until the arena is modified or destroyed.
+     */
+    class BlueprintArena {
+    public:
+
+        BlueprintArena();
+
+        /**
+         *  \brief  Build the AST out of a blueprint.
+         *  \param  blueprint   A blueprint AST to copy.
+         *  \param  source      Source the blueprint was parsed from,
+         *                      empty to intern all the strings.
+         */
+        BlueprintArena(const Blueprint& blueprint, const SourceData& source);
+
+        /** \copydoc BlueprintArena(const Blueprint&, const SourceData&) */
+        void assign(const Blueprint& blueprint, const SourceData& source);
+
+        /** Release the AST */
+        void clear();
+
+        /** \return The AST */
+        const ArenaBlueprint& blueprint() const { return m_blueprint; }
+
+        /** Convert the AST to a %Blueprint */
+        void materialize(Blueprint& blueprint) const;
+
+        /** \return Number of string bytes pointing into the retained source */
+        size_t slicedLength() const { return m_slicedLength; }
+
+        /** \return Number of distinct strings interned in the arena */
+        size_t internedCount() const { return m_internedCount; }
+
+        /** \return Approximate number of bytes held by the arena */
+        size_t memoryFootprint() const { return m_arena.capacity(); }
+
+    private:
+        Arena m_arena;
+        ArenaBlueprint m_blueprint;
+        size_t m_slicedLength;
+        size_t m_internedCount;
+
+        BlueprintArena(const BlueprintArena&);
+        BlueprintArena& operator=(const BlueprintArena&);
+    };
+}
+
+#endif
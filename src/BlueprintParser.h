@@ -10,12 +10,15 @@
 #define SNOWCRASH_BLUEPRINTPARSER_H
 
 #include <functional>
+#include <map>
+#include <set>
 #include <sstream>
 #include <iterator>
 #include "Blueprint.h"
 #include "BlueprintParserCore.h"
 #include "ResourceParser.h"
 #include "ResourceGroupParser.h"
+#include "WorkerThreads.h"
 
 namespace snowcrashconst {
     
@@ -160,7 +163,7 @@ namespace snowcrash {
             }
             
             // Description
-            result = ParseDescriptionBlock<Blueprint>(section, sectionCur, parser.sourceData, output);
+            result = ParseDescriptionBlock<Blueprint>(section, sectionCur, parser, output);
             
             // Check Name
             if (isFirstBlock)
@@ -181,19 +184,19 @@ namespace snowcrash {
                 !CheckBlueprintName(cur, output, parser, result.first))
                 return result;
             
-            // Parser resource group
+            // Parser resource group, unless parsed ahead
             ResourceGroup resourceGroup;
-            result = ResourceGroupParser::Parse(cur,
-                                                section.bounds.second,
-                                                section,
-                                                parser,
-                                                resourceGroup);
+            if (!AdoptPrefetchedResourceGroup(cur, parser, resourceGroup, result))
+                result = ResourceGroupParser::Parse(cur,
+                                                    section.bounds.second,
+                                                    section,
+                                                    parser,
+                                                    resourceGroup);
 
             if (result.first.error.code != Error::OK)
                 return result;
             
-            Collection<ResourceGroup>::const_iterator duplicate = FindResourceGroup(parser.blueprint, resourceGroup);
-            if (duplicate != parser.blueprint.resourceGroups.end()) {
+            if (!parser.resourceIndex.groupNames.insert(resourceGroup.name).second) {
                 
                 // WARN: duplicate group
                 std::stringstream ss;
@@ -211,11 +214,94 @@ namespace snowcrash {
                                                         sourceBlock));
             }
             
-            output.resourceGroups.push_back(resourceGroup); // FIXME: C++11 move
+            output.resourceGroups.push_back(std::move(resourceGroup));
             return result;
         }
         
 
+        /** Append model definitions or references of a group parsed ahead */
+        static void AppendResourceModelReferences(ResourceModelReferences& adopted,
+                                                  ResourceModelReferences& references) {
+            
+            references.insert(references.end(),
+                              std::make_move_iterator(adopted.begin()),
+                              std::make_move_iterator(adopted.end()));
+        }
+        
+        /** \return True if a group parsed ahead starts before a block */
+        static bool PrefetchedBefore(const PrefetchedResourceGroup& prefetched, const BlockIterator& cur) {
+            return prefetched.begin < cur;
+        }
+        
+        /**
+         *  \brief  Adopt a resource group parsed ahead from a block.
+         *  \return True if the group was adopted, false if it has to be parsed.
+         *
+         *  A group parsed ahead has not seen the groups preceding it. It
+         *  is adopted only if they could not affect its parsing: it has no
+         *  error, it refers only to models known to it, none of its models
+         *  is defined already and none of its resources is defined already.
+         */
+        static bool AdoptPrefetchedResourceGroup(const BlockIterator& cur,
+                                                 BlueprintParserCore& parser,
+                                                 ResourceGroup& group,
+                                                 ParseSectionResult& result) {
+            
+            std::vector<PrefetchedResourceGroup>& prefetched = parser.prefetchedResourceGroups;
+            std::vector<PrefetchedResourceGroup>::iterator entry = std::lower_bound(prefetched.begin(),
+                                                                                    prefetched.end(),
+                                                                                    cur,
+                                                                                    PrefetchedBefore);
+            if (entry == prefetched.end() ||
+                entry->begin != cur ||
+                !entry->parsed ||
+                entry->result.first.error.code != Error::OK ||
+                !entry->forwardReferences.empty())
+                return false;
+            
+            ResourceModelSymbolTable& resourceModels = parser.symbolTable.resourceModels;
+            for (ResourceModelSymbolTable::const_iterator it = entry->resourceModels.begin();
+                 it != entry->resourceModels.end();
+                 ++it) {
+                
+                if (resourceModels.find(it->first) != resourceModels.end())
+                    return false;
+            }
+            
+            std::set<URITemplate>& uriTemplates = parser.resourceIndex.uriTemplates;
+            for (Collection<Resource>::const_iterator it = entry->group.resources.begin();
+                 it != entry->group.resources.end();
+                 ++it) {
+                
+                if (uriTemplates.find(it->uriTemplate) != uriTemplates.end())
+                    return false;
+            }
+            
+            resourceModels.insert(std::make_move_iterator(entry->resourceModels.begin()),
+                                  std::make_move_iterator(entry->resourceModels.end()));
+            parser.symbolTable.modelDescriptionBytes.insert(entry->modelDescriptionBytes.begin(),
+                                                            entry->modelDescriptionBytes.end());
+            AppendResourceModelReferences(entry->definitions, parser.symbolTable.definitions);
+            AppendResourceModelReferences(entry->references, parser.symbolTable.references);
+            for (Collection<Resource>::const_iterator it = entry->group.resources.begin();
+                 it != entry->group.resources.end();
+                 ++it)
+                uriTemplates.insert(it->uriTemplate);
+            
+            parser.budget.spendASTBytes(entry->astBytes);
+            
+            group.name.swap(entry->group.name);
+            group.description.swap(entry->group.description);
+            group.resources.swap(entry->group.resources);
+            
+            result.first.error = entry->result.first.error;
+            result.first.warnings.swap(entry->result.first.warnings);
+            result.second = entry->result.second;
+            
+            entry->parsed = false;
+            return true;
+        }
+        
         static ParseSectionResult ParseMetadataBlock(const BlockIterator& cur,
                                                      const SectionBounds& bounds,
                                                      BlueprintParserCore& parser,
@@ -235,45 +321,42 @@ namespace snowcrash {
                 
                 Metadata metadata;
                 if (KeyValueFromLine(*line, metadata))
-                    metadataCollection.push_back(metadata);
+                    metadataCollection.push_back(std::move(metadata));
             }
             
             if (lines.size() == metadataCollection.size()) {
                 
-                // Check duplicates
-                std::vector<std::string> duplicateKeys;
+                // Check duplicates, warn once per key in the order of its first definition
+                std::map<std::string, size_t> keyCounts;
+                for (MetadataCollectionIterator it = metadataCollection.begin();
+                     it != metadataCollection.end();
+                     ++it)
+                    ++keyCounts[it->first];
+                
                 for (MetadataCollectionIterator it = metadataCollection.begin();
                      it != metadataCollection.end();
                      ++it) {
                     
-                    MetadataCollectionIterator from = it;
-                    if (++from == metadataCollection.end())
-                        break;
+                    std::map<std::string, size_t>::iterator keyCount = keyCounts.find(it->first);
+                    if (keyCount == keyCounts.end() || keyCount->second < 2)
+                        continue;
                     
-                    MetadataCollectionIterator duplicate = std::find_if(from,
-                                                                        metadataCollection.end(),
-                                                                        std::bind2nd(MatchFirsts<Metadata>(), *it));
+                    keyCounts.erase(keyCount);
                     
-                    if (duplicate != metadataCollection.end() &&
-                        std::find(duplicateKeys.begin(), duplicateKeys.end(), it->first) == duplicateKeys.end()) {
-                        
-                        duplicateKeys.push_back(it->first);
-                        
-                        // WARN: duplicate metada definition
-                        std::stringstream ss;
-                        ss << "duplicate definition of '" << it->first << "'";
-                        
-                        SourceCharactersBlock sourceBlock = CharacterMapForBlock(cur, bounds.second, bounds, parser.sourceData);
-                        result.first.warnings.push_back(Warning(ss.str(),
-                                                                DuplicateWarning,
-                                                                sourceBlock));
-                    }
+                    // WARN: duplicate metada definition
+                    std::stringstream ss;
+                    ss << "duplicate definition of '" << it->first << "'";
+                    
+                    SourceCharactersBlock sourceBlock = CharacterMapForBlock(cur, bounds.second, bounds, parser.sourceData);
+                    result.first.warnings.push_back(Warning(ss.str(),
+                                                            DuplicateWarning,
+                                                            sourceBlock));
                 }
                 
                 // Insert parsed metadata into output
                 output.metadata.insert(output.metadata.end(),
-                                       metadataCollection.begin(),
-                                       metadataCollection.end());
+                                       std::make_move_iterator(metadataCollection.begin()),
+                                       std::make_move_iterator(metadataCollection.end()));
                 
                 ++result.second;
             }
@@ -298,21 +381,50 @@ namespace snowcrash {
     //
     class BlueprintParser {
     public:
-        // Parse Markdown AST into API Blueprint AST
+        // Parse Markdown AST into API Blueprint AST, streaming warnings to an optional callback
+        // and indexing the model symbols into an optional symbol index
         static void Parse(const SourceData& sourceData,
                           const MarkdownBlock::Stack& source,
                           BlueprintParserOptions options,
                           Result& result,
-                          Blueprint& blueprint) {
+                          Blueprint& blueprint,
+                          WarningCallback warningCallback = NULL,
+                          void* warningCallbackData = NULL,
+                          const ParserBudget& budget = ParserBudget(),
+                          SymbolIndex* symbolIndex = NULL) {
+            
+            if (symbolIndex)
+                symbolIndex->clear();
             
             BlueprintParserCore parser(options, sourceData, blueprint);
-            BlueprintSection rootSection(std::make_pair(source.begin(), source.end()));
-            ParseSectionResult sectionResult = BlueprintParserInner::Parse(source.begin(),
-                                                                           source.end(),
-                                                                           rootSection,
-                                                                           parser,
-                                                                           blueprint);
-            result += sectionResult.first;
+            parser.markdown = &source;
+            parser.diagnostics.setCallback(warningCallback, warningCallbackData);
+            parser.budget.start(budget);
+            SignatureMemo::Scope signatureMemoScope(parser.signatureMemo, source);
+            SourceCharacterIndex::Scope sourceCharacterIndexScope(parser.sourceCharacterIndex,
+                                                                  (options & SkipSourceMapOption) != 0);
+            
+            if (!CheckMarkdownBudget(source, parser, result))
+                return;
+            
+            ParseSectionResult sectionResult = ParseBlueprint(source, parser, blueprint);
+            
+            if (sectionResult.first.error.code == Error::OK)
+                LinkResourceModelReferences(parser, blueprint, sectionResult.first);
+            
+            if (symbolIndex)
+                BuildSymbolIndex(parser.symbolTable, parser.sourceData, *symbolIndex);
+            
+            parser.diagnostics.release(sectionResult.first.warnings);
+            
+            // Hand the warnings over without copying when possible
+            if (result.warnings.empty()) {
+                result.error = sectionResult.first.error;
+                result.warnings.swap(sectionResult.first.warnings);
+            }
+            else {
+                result += sectionResult.first;
+            }
             
 #ifdef DEBUG
             PrintSymbolTable(parser.symbolTable);
@@ -323,6 +435,238 @@ namespace snowcrash {
             PostParseCheck(sourceData, source, parser, result);
         }
         
+        /** Parse the blueprint, ahead on the workers if requested */
+        static ParseSectionResult ParseBlueprint(const MarkdownBlock::Stack& source,
+                                                 BlueprintParserCore& parser,
+                                                 Blueprint& blueprint) {
+            
+            // Groups parsed ahead do not see the budget spent before them
+            if ((parser.options & ParallelResourceGroupsOption) &&
+                !parser.budget.active())
+                PrefetchResourceGroups(source, parser, WorkerConcurrency());
+            
+            BlueprintSection rootSection(std::make_pair(source.begin(), source.end()));
+            ParseSectionResult result = BlueprintParserInner::Parse(source.begin(),
+                                                                    source.end(),
+                                                                    rootSection,
+                                                                    parser,
+                                                                    blueprint);
+            parser.prefetchedResourceGroups.clear();
+            return result;
+        }
+        
+        /** 
+         *  \brief  Check the markdown blocks against the parser budget.
+         *  \return False if the budget is exceeded, true otherwise.
+         */
+        static bool CheckMarkdownBudget(const MarkdownBlock::Stack& source,
+                                        const BlueprintParserCore& parser,
+                                        Result& result) {
+            
+            const ParserBudget& budget = parser.budget.budget();
+            BlockIterator exceeded = source.end();
+            size_t limit = 0;
+            const char* limitName = NULL;
+            
+            if (budget.maxBlocks && source.size() > budget.maxBlocks) {
+                exceeded = source.begin() + budget.maxBlocks;
+                limit = budget.maxBlocks;
+                limitName = "markdown blocks";
+            }
+            else if (budget.maxNesting) {
+                size_t depth = 0;
+                for (BlockIterator it = source.begin(); it != source.end(); ++it) {
+                    
+                    if (it->type == QuoteBlockBeginType ||
+                        it->type == ListBlockBeginType) {
+                        
+                        if (++depth > budget.maxNesting) {
+                            exceeded = it;
+                            limit = budget.maxNesting;
+                            limitName = "nested markdown blocks";
+                            break;
+                        }
+                    }
+                    else if (depth &&
+                             (it->type == QuoteBlockEndType ||
+                              it->type == ListBlockEndType)) {
+                        --depth;
+                    }
+                }
+            }
+            
+            if (exceeded == source.end())
+                return true;
+            
+            // ERR: Budget exceeded
+            std::stringstream ss;
+            ss << "exceeded the parser budget of " << limit << " " << limitName;
+            result.error = Error(ss.str(),
+                                 BudgetError,
+                                 MapSourceDataBlock(exceeded->sourceMap, parser.sourceData));
+            return false;
+        }
+        
+        /** \return The first reference to a model not defined in the whole blueprint */
+        static ResourceModelReferences::const_iterator FindUndefinedReference(const SymbolTable& symbolTable) {
+            
+            ResourceModelReferences::const_iterator it = symbolTable.forwardReferences.begin();
+            for (; it != symbolTable.forwardReferences.end(); ++it) {
+                if (!FindResourceModel(symbolTable, it->symbol))
+                    break;
+            }
+            
+            return it;
+        }
+        
+        /**
+         *  \brief  Resolve the references to models defined later in a parsed blueprint.
+         *
+         *  The payloads referring to a model defined before them are resolved
+         *  as they are parsed. The payloads referring to a model defined later
+         *  are resolved here, in the document order, and checked once resolved.
+         *  Their warnings follow the warnings of the parse.
+         */
+        static void LinkResourceModelReferences(BlueprintParserCore& parser,
+                                                Blueprint& blueprint,
+                                                Result& result) {
+            
+            const SymbolTable& symbolTable = parser.symbolTable;
+            if (symbolTable.forwardReferences.empty())
+                return;
+            
+            ResourceModelReferences::const_iterator undefined = FindUndefinedReference(symbolTable);
+            if (undefined != symbolTable.forwardReferences.end()) {
+                
+                // ERR: Undefined symbol, the model expected ahead is not defined after all
+                std::stringstream ss;
+                ss << "undefined symbol '" << undefined->symbol.name << "'";
+                result.error = Error(ss.str(),
+                                     SymbolError,
+                                     MapSourceDataBlock(undefined->sourceMap, parser.sourceData));
+                return;
+            }
+            
+            // Stream the warnings of the deferred checks with the result
+            parser.diagnostics.hold();
+            
+            size_t next = 0;
+            for (Collection<ResourceGroup>::iterator group = blueprint.resourceGroups.begin();
+                 group != blueprint.resourceGroups.end();
+                 ++group) {
+                
+                for (Collection<Resource>::iterator resource = group->resources.begin();
+                     resource != group->resources.end();
+                     ++resource) {
+                    
+                    for (Collection<Action>::iterator action = resource->actions.begin();
+                         action != resource->actions.end();
+                         ++action) {
+                        
+                        for (Collection<TransactionExample>::iterator example = action->examples.begin();
+                             example != action->examples.end();
+                             ++example) {
+                            
+                            LinkPayloads(parser, example->requests, next, result);
+                            LinkPayloads(parser, example->responses, next, result);
+                        }
+                    }
+                    
+                    if (!parser.budget.check(result.warnings.size())) {
+                        
+                        // ERR: Budget exceeded
+                        result.error = Error(parser.budget.exceededMessage(result.warnings.size()),
+                                             BudgetError,
+                                             MapSourceDataBlock(MakeSourceDataBlock(0, 0), parser.sourceData));
+                        return;
+                    }
+                }
+            }
+        }
+        
+        /**
+         *  \brief  Resolve the payloads referring to a model defined later.
+         *  \param  next    Index of the next forward reference to resolve.
+         *
+         *  A payload refers to a model defined later only before the model's
+         *  definition, the payloads referring to it afterwards are resolved
+         *  already and do not match the next forward reference.
+         */
+        static void LinkPayloads(BlueprintParserCore& parser,
+                                 Collection<Payload>::type& payloads,
+                                 size_t& next,
+                                 Result& result) {
+            
+            const ResourceModelReferences& forwardReferences = parser.symbolTable.forwardReferences;
+            for (Collection<Payload>::iterator it = payloads.begin();
+                 it != payloads.end() && next < forwardReferences.size();
+                 ++it) {
+                
+                if (it->reference.empty() ||
+                    it->reference != forwardReferences[next].symbol.name)
+                    continue;
+                
+                // The body and schema are shared with the model, only the description is copied
+                const ResourceModel& model = *FindResourceModel(parser.symbolTable, forwardReferences[next].symbol);
+                ResolveResourceModelReference(model, *it);
+                parser.budget.spendASTBytes(ResourceModelDescriptionBytes(parser.symbolTable, forwardReferences[next].symbol));
+                
+                if (next < parser.deferredPayloadChecks.size()) {
+                    const DeferredPayloadCheck& check = parser.deferredPayloadChecks[next];
+                    SectionParser<Action>::CheckPayload(check.section,
+                                                        *it,
+                                                        check.method,
+                                                        check.sourceMap,
+                                                        parser.sourceData,
+                                                        result);
+                }
+                
+                ++next;
+            }
+        }
+        
+        /**
+         *  \brief  Parse the top-level resource groups ahead on a number of workers.
+         *
+         *  Groups start at the first resource or resource group and at every
+         *  resource group after it. Each worker parses every n-th group as if
+         *  no group preceded it, the parser then adopts the groups in the
+         *  document order or parses them again when the preceding groups
+         *  matter, see %SectionParser<Blueprint>::AdoptPrefetchedResourceGroup().
+         */
+        static void PrefetchResourceGroups(const MarkdownBlock::Stack& source,
+                                           BlueprintParserCore& parser,
+                                           size_t workers) {
+            
+            std::vector<PrefetchedResourceGroup>& groups = parser.prefetchedResourceGroups;
+            for (BlockIterator it = source.begin(); it != source.end(); ++it) {
+                
+                if (HasResourceGroupSignature(*it) ||
+                    (groups.empty() && HasResourceSignature(*it))) {
+                    
+                    groups.push_back(PrefetchedResourceGroup());
+                    groups.back().begin = it;
+                }
+            }
+            
+            if (groups.size() < 2 || !workers) {
+                groups.clear();
+                return;
+            }
+            
+            // Workers share the index, build it beforehand
+            if ((parser.options & SkipSourceMapOption) == 0)
+                parser.sourceCharacterIndex.build();
+            
+            PrefetchWork work = { &parser.sourceData,
+                                  &source,
+                                  &parser.sourceCharacterIndex,
+                                  parser.options,
+                                  &groups,
+                                  std::min(workers, groups.size()) };
+            RunWorkers(PrefetchWorker, &work, work.workers);
+        }
+        
         /** 
          *  Perform additional post-parsing result checks.
          *  Mainly to focused on running checking when top-level parser is not executed.
@@ -341,6 +685,68 @@ namespace snowcrash {
                                      MapSourceDataBlock(MakeSourceDataBlock(0, 0), parser.sourceData));
             }
         }
+        
+    private:
+        /** Work shared by the workers parsing resource groups ahead */
+        struct PrefetchWork {
+            const SourceData* sourceData;
+            const MarkdownBlock::Stack* source;
+            const SourceCharacterIndex* sourceCharacterIndex;
+            BlueprintParserOptions options;
+            std::vector<PrefetchedResourceGroup>* groups;
+            size_t workers;
+        };
+        
+        static void PrefetchWorker(size_t worker, void* data) {
+            
+            PrefetchWork& work = *static_cast<PrefetchWork*>(data);
+            std::vector<PrefetchedResourceGroup>& groups = *work.groups;
+            const MarkdownBlock::Stack& source = *work.source;
+            
+            // No groups precede a group parsed ahead
+            Blueprint blueprint;
+            BlueprintParserCore parser(work.options, *work.sourceData, blueprint);
+            parser.markdown = &source;
+            SignatureMemo::Scope signatureMemoScope(parser.signatureMemo, source);
+            SourceCharacterIndex::Scope sourceCharacterIndexScope(*work.sourceCharacterIndex,
+                                                                  (work.options & SkipSourceMapOption) != 0);
+            
+            SectionBounds bounds = std::make_pair(source.begin(), source.end());
+            BlueprintSection rootSection(bounds);
+            
+            for (size_t i = worker; i < groups.size(); i += work.workers) {
+                
+                PrefetchedResourceGroup& prefetched = groups[i];
+                BlueprintSection section(ResourceGroupSectionType, bounds, rootSection);
+                parser.budget.resetASTBytes();
+                try {
+                    prefetched.result = ResourceGroupParser::Parse(prefetched.begin,
+                                                                   bounds.second,
+                                                                   section,
+                                                                   parser,
+                                                                   prefetched.group);
+                    prefetched.parsed = true;
+                }
+                catch (...) {
+                    // Left to the parser
+                    parser.diagnostics = DiagnosticsSink();
+                }
+                
+                prefetched.resourceModels.swap(parser.symbolTable.resourceModels);
+                prefetched.modelDescriptionBytes.swap(parser.symbolTable.modelDescriptionBytes);
+                prefetched.forwardReferences.swap(parser.symbolTable.forwardReferences);
+                prefetched.definitions.swap(parser.symbolTable.definitions);
+                prefetched.references.swap(parser.symbolTable.references);
+                prefetched.astBytes = parser.budget.astBytes();
+                parser.symbolTable.resourceModels.clear();
+                parser.symbolTable.modelDescriptionBytes.clear();
+                parser.symbolTable.forwardReferences.clear();
+                parser.symbolTable.definitions.clear();
+                parser.symbolTable.references.clear();
+                parser.deferredPayloadChecks.clear();
+                parser.resourceIndex.clear();
+            }
+        }
     };
 }
 
@@ -10,7 +10,10 @@
 #define SNOWCRASH_BLUEPRINTPARSERCORE_H
 
 #include <algorithm>
+#include <iterator>
+#include <set>
 #include <sstream>
+#include <utility>
 #include "ParserCore.h"
 #include "SourceAnnotation.h"
 #include "MarkdownBlock.h"
@@ -20,6 +23,8 @@
 #include "BlueprintUtility.h"
 #include "StringUtility.h"
 #include "SymbolTable.h"
+#include "SignatureMemo.h"
+#include "Clock.h"
 
 namespace snowcrash {
     
@@ -30,11 +35,31 @@ namespace snowcrash {
      */
     enum BlueprintParserOption {
         RenderDescriptionsOption = (1 << 0),    /// < Render Markdown in description.
-        RequireBlueprintNameOption = (1 << 1)   /// < Treat missing blueprint name as error
+        RequireBlueprintNameOption = (1 << 1),  /// < Treat missing blueprint name as error
+        SkipSourceMapOption = (1 << 2),         /// < Do not map annotations to source characters
+        ValidateOnlyOption = (1 << 3),          /// < Report annotations only, do not retrieve descriptions & assets
+        ParallelResourceGroupsOption = (1 << 4) /// < Parse resource groups ahead on worker threads, unless a budget limit is set
     };
     
     typedef unsigned int BlueprintParserOptions;
     
+    /**
+     *  \brief Limits of the resources spent parsing a document.
+     *
+     *  A parse exceeding a limit stops with the %BudgetError.
+     *  Zero stands for no limit.
+     */
+    struct ParserBudget {
+        ParserBudget()
+        : maxBlocks(0), maxNesting(0), maxWarnings(0), maxTime(0), maxASTBytes(0) {}
+        
+        size_t maxBlocks;       /// < Markdown blocks of the document
+        size_t maxNesting;      /// < Nesting depth of the markdown blocks
+        size_t maxWarnings;     /// < Warnings reported
+        size_t maxTime;         /// < Wall-clock time in milliseconds
+        size_t maxASTBytes;     /// < Descriptions and assets of the AST in bytes
+    };
+    
     /**
      *  \brief Parsing subroutine result
      *
@@ -44,6 +69,258 @@ namespace snowcrash {
      */
     typedef std::pair<Result, BlockIterator> ParseSectionResult;
     
+    /**
+     *  \brief Warning callback.
+     *
+     *  Invoked with every warning as it is found, %data is the
+     *  user data registered along with the callback.
+     */
+    typedef void (*WarningCallback)(const Warning& warning, void* data);
+    
+    /**
+     *  \brief Sink of the warnings found while parsing.
+     *
+     *  Block parsers hand the warnings of each parsed section over
+     *  to the sink instead of accumulating them in their results, so
+     *  the warnings are not copied up the section tree. The outermost
+     *  block parser takes all the collected warnings back into its
+     *  result. Warnings are streamed to an optional callback as they
+     *  are handed over.
+     */
+    class DiagnosticsSink {
+    public:
+        DiagnosticsSink()
+        : m_depth(0), m_callback(NULL), m_callbackData(NULL), m_held(false), m_streamed(0) {}
+        
+        /** Set the callback invoked with every warning, NULL for none */
+        void setCallback(WarningCallback callback, void* data) {
+            m_callback = callback;
+            m_callbackData = data;
+        }
+        
+        /** \return Number of warnings taken over so far */
+        size_t size() const {
+            return m_warnings.size();
+        }
+        
+        /** Enter a block parser */
+        void enter() {
+            ++m_depth;
+        }
+        
+        /** Take warnings over, %warnings are cleared */
+        void append(Warnings& warnings) {
+            for (Warnings::iterator it = warnings.begin(); it != warnings.end(); ++it) {
+                if (m_callback && !m_held) {
+                    m_callback(*it, m_callbackData);
+                    ++m_streamed;
+                }
+                
+                m_warnings.push_back(std::move(*it));
+            }
+            
+            warnings.clear();
+        }
+        
+        /** 
+         *  \brief Stop invoking the callback until release().
+         *
+         *  Used when warnings are added once the block parsers are done.
+         */
+        void hold() {
+            m_held = true;
+        }
+        
+        /** Invoke the callback with the final %warnings not streamed yet */
+        void release(const Warnings& warnings) {
+            if (!m_held)
+                return;
+            
+            m_held = false;
+            for (size_t i = m_streamed; i < warnings.size(); ++i) {
+                if (m_callback)
+                    m_callback(warnings[i], m_callbackData);
+            }
+            
+            m_streamed = warnings.size();
+        }
+        
+        /**
+         *  \brief Leave a block parser taking its remaining warnings over.
+         *
+         *  Leaving the outermost block parser hands all the collected
+         *  warnings back in %warnings.
+         */
+        void leave(Warnings& warnings) {
+            append(warnings);
+            
+            if (--m_depth == 0)
+                warnings.swap(m_warnings);
+        }
+        
+    private:
+        Warnings m_warnings;
+        size_t m_depth;
+        WarningCallback m_callback;
+        void* m_callbackData;
+        bool m_held;
+        size_t m_streamed;
+    };
+    
+    
+    /**
+     *  \brief Meter of the budget spent parsing.
+     *
+     *  The limits of the AST and the warnings are checked as the parser
+     *  proceeds, the clock is read only every %ClockInterval checks.
+     *  The markdown limits are checked once before parsing.
+     */
+    class BudgetMeter {
+    public:
+        /** Number of checks between reading the clock */
+        static const size_t ClockInterval = 64;
+        
+        BudgetMeter()
+        : m_active(false), m_start(0), m_checks(0), m_astBytes(0), m_descriptionBytes(0) {}
+        
+        /** Start spending a budget */
+        void start(const ParserBudget& budget) {
+            m_budget = budget;
+            m_active = (budget.maxWarnings || budget.maxTime || budget.maxASTBytes);
+            m_start = ClockMilliseconds();
+            m_checks = 0;
+            m_astBytes = 0;
+            m_descriptionBytes = 0;
+        }
+        
+        const ParserBudget& budget() const {
+            return m_budget;
+        }
+        
+        /** \return True if a limit checked while parsing is set */
+        bool active() const {
+            return m_active;
+        }
+        
+        /** Account bytes retrieved into the AST */
+        void spendASTBytes(size_t bytes) {
+            m_astBytes += bytes;
+        }
+        
+        size_t astBytes() const {
+            return m_astBytes;
+        }
+        
+        /**
+         *  \brief Account description bytes retrieved into the AST.
+         *
+         *  Spent the same whether the description is retrieved or only
+         *  validated, see %descriptionBytes().
+         */
+        void spendDescriptionBytes(size_t bytes) {
+            m_astBytes += bytes;
+            m_descriptionBytes += bytes;
+        }
+        
+        /** \return Description bytes spent since the budget was started */
+        size_t descriptionBytes() const {
+            return m_descriptionBytes;
+        }
+        
+        /** Start accounting a new AST */
+        void resetASTBytes() {
+            m_astBytes = 0;
+        }
+        
+        /** \return True if the parse is within the budget */
+        bool check(size_t warnings) {
+            if (!m_active)
+                return true;
+            
+            return (!m_budget.maxWarnings || warnings <= m_budget.maxWarnings) &&
+                   (!m_budget.maxASTBytes || m_astBytes <= m_budget.maxASTBytes) &&
+                   (!m_budget.maxTime || ++m_checks % ClockInterval || !timeExceeded());
+        }
+        
+        /** \return Message of the exceeded limit, empty if within the budget */
+        std::string exceededMessage(size_t warnings) const {
+            std::stringstream ss;
+            if (m_budget.maxWarnings && warnings > m_budget.maxWarnings)
+                ss << "exceeded the parser budget of " << m_budget.maxWarnings << " warnings";
+            else if (m_budget.maxASTBytes && m_astBytes > m_budget.maxASTBytes)
+                ss << "exceeded the parser budget of " << m_budget.maxASTBytes << " AST bytes";
+            else if (m_budget.maxTime && timeExceeded())
+                ss << "exceeded the parser budget of " << m_budget.maxTime << " ms";
+            
+            return ss.str();
+        }
+        
+    private:
+        ParserBudget m_budget;
+        bool m_active;
+        size_t m_start;
+        size_t m_checks;
+        size_t m_astBytes;
+        size_t m_descriptionBytes;
+        
+        bool timeExceeded() const {
+            return ClockMilliseconds() - m_start > m_budget.maxTime;
+        }
+    };
+    
+    
+    /**
+     *  \brief Resource groups and resources parsed so far.
+     *
+     *  Looks up duplicate definitions in logarithmic time instead
+     *  of walking the whole AST for every group and resource.
+     */
+    struct ResourceIndex {
+        
+        /** Names of the resource groups */
+        std::set<Name> groupNames;
+        
+        /** URI templates of the resources */
+        std::set<URITemplate> uriTemplates;
+        
+        void clear() {
+            groupNames.clear();
+            uriTemplates.clear();
+        }
+    };
+    
+    /**
+     *  \brief A resource group parsed ahead by a worker.
+     *
+     *  See %ParallelResourceGroupsOption.
+     */
+    struct PrefetchedResourceGroup {
+        PrefetchedResourceGroup() : astBytes(0), parsed(false) {}
+        
+        BlockIterator begin;                        /// < First block of the group
+        ResourceGroup group;                        /// < Parsed group
+        ParseSectionResult result;                  /// < Result of the group parser
+        ResourceModelSymbolTable resourceModels;    /// < Models defined by the group
+        ResourceModelSizes modelDescriptionBytes;   /// < Description bytes of the models of the group
+        ResourceModelReferences forwardReferences;  /// < References to models not defined by the group
+        ResourceModelReferences definitions;        /// < Definitions of the models of the group
+        ResourceModelReferences references;         /// < References to models made by the group
+        size_t astBytes;                            /// < AST bytes spent by the group
+        bool parsed;                                /// < True if the group was parsed
+    };
+    
+    /**
+     *  \brief Check of a payload deferred until its model is resolved.
+     *
+     *  A payload referring to a model defined later in the blueprint is
+     *  checked once the model is resolved into it, see
+     *  %SectionParser<Blueprint>::LinkResourceModelReferences().
+     */
+    struct DeferredPayloadCheck {
+        SectionType section;            /// < Section of the payload
+        HTTPMethod method;              /// < Method of the action of the payload
+        SourceDataBlock sourceMap;      /// < Source map of the payload signature
+    };
     
     /**
      *  Parser Core Data
@@ -52,17 +329,51 @@ namespace snowcrash {
         BlueprintParserCore(BlueprintParserOptions opts,
                             const SourceData& src,
                             const Blueprint& bp)
-        : options(opts), sourceData(src), blueprint(bp) {}
+        : m_sourceCharacterIndex(src),
+          options(opts),
+          sourceCharacterIndex((SourceCharacterIndex::Active(src)) ? *SourceCharacterIndex::Active(src) : m_sourceCharacterIndex),
+          sourceData(src),
+          markdown(NULL),
+          blueprint(bp) {}
         
+    private:
+        /** Character index of the source data unless the caller has one active */
+        SourceCharacterIndex m_sourceCharacterIndex;
+        
+    public:
         /** Parser Options */
         BlueprintParserOptions options;
         
         /** Symbol Table */
         SymbolTable symbolTable;
         
+        /** Block Signature Memo */
+        SignatureMemo signatureMemo;
+        
+        /** Source Data Character Index, reused when already active for the source data */
+        const SourceCharacterIndex& sourceCharacterIndex;
+        
+        /** Warnings Sink */
+        DiagnosticsSink diagnostics;
+        
+        /** Parser Budget */
+        BudgetMeter budget;
+        
+        /** Resource Groups and Resources Parsed So Far */
+        ResourceIndex resourceIndex;
+        
+        /** Resource Groups Parsed Ahead, in the document order */
+        std::vector<PrefetchedResourceGroup> prefetchedResourceGroups;
+        
+        /** Checks of the payloads in %SymbolTable::forwardReferences, in the same order */
+        std::vector<DeferredPayloadCheck> deferredPayloadChecks;
+        
         /** Source Data */
         const SourceData& sourceData;
         
+        /** Markdown Blocks of the Whole Blueprint, NULL if not known */
+        const MarkdownBlock::Stack* markdown;
+        
         /** AST being parsed **/
         const Blueprint& blueprint;
         
@@ -72,6 +383,27 @@ namespace snowcrash {
         BlueprintParserCore& operator=(const BlueprintParserCore&);
     };
     
+    /**
+     *  \brief  Check the parser budget.
+     *  \param  cur     The block being parsed.
+     *  \param  parser  Parser instance.
+     *  \param  result  Result to report the exceeded budget into.
+     *  \return False if the budget is exceeded, true otherwise.
+     */
+    FORCEINLINE bool CheckBudget(const BlockIterator& cur,
+                                 BlueprintParserCore& parser,
+                                 Result& result) {
+        
+        if (parser.budget.check(parser.diagnostics.size()))
+            return true;
+        
+        // ERR: Budget exceeded
+        result.error = Error(parser.budget.exceededMessage(parser.diagnostics.size()),
+                             BudgetError,
+                             MapSourceDataBlock(cur->sourceMap, parser.sourceData));
+        return false;
+    }
+    
     /**
      *  SectionType Parser prototype.
      */
@@ -157,6 +489,7 @@ namespace snowcrash {
             Result result;
             SectionType currentSectionType = UndefinedSectionType;
             BlockIterator currentBlock = begin;
+            parser.diagnostics.enter();
             while (currentBlock != end) {
                 
                 currentSectionType = ClassifyBlock<T>(currentBlock, end, currentSectionType);
@@ -167,10 +500,15 @@ namespace snowcrash {
                                                                    parser,
                                                                    output);
                 
-                result += sectionResult.first;
+                // Warnings go to the sink, only the error is kept
+                result.error = sectionResult.first.error;
+                parser.diagnostics.append(sectionResult.first.warnings);
                 if (result.error.code != Error::OK)
                     break;
                 
+                if (!CheckBudget(currentBlock, parser, result))
+                    break;
+                
                 if (sectionResult.second == currentBlock)
                     break;
 
@@ -181,6 +519,7 @@ namespace snowcrash {
             }
             
             P::Finalize(std::make_pair(begin, currentBlock), parser, output, result);
+            parser.diagnostics.leave(result.warnings);
             
             return std::make_pair(result, currentBlock);
         }        
@@ -22,7 +22,7 @@ namespace snowcrash {
      *  Two pairs are a match if their %first matches.
      */
     template <class T>
-    struct MatchFirsts : std::binary_function<T, T, bool> {
+    struct MatchFirsts {
         bool operator()(const T& left, const T& right) const {
             return left.first == right.first;
         }
@@ -32,7 +32,7 @@ namespace snowcrash {
      *  \brief Matches a pair's first against a value.
      */
     template <class T, class R>
-    struct MatchFirstWith : std::binary_function<T, R, bool> {
+    struct MatchFirstWith {
         bool operator()(const T& left, const R& right) const {
             return left.first == right;
         }
@@ -40,7 +40,7 @@ namespace snowcrash {
     
     /**  A name matching predicate. */
     template <class T>
-    struct MatchName : std::binary_function<T, T, bool> {
+    struct MatchName {
         bool operator()(const T& first, const T& second) const {
             return first.name == second.name;
         }
@@ -51,8 +51,8 @@ namespace snowcrash {
      *
      *  Matches payloads if their name and media type matches.
      */
-    struct MatchPayload : std::binary_function<Payload, Payload, bool> {
-        bool operator()(const first_argument_type& left, const second_argument_type& right) const {
+    struct MatchPayload {
+        bool operator()(const Payload& left, const Payload& right) const {
             
 
             if (left.name != right.name)
@@ -62,8 +62,8 @@ namespace snowcrash {
             Collection<Header>::const_iterator header;
             header = std::find_if(left.headers.begin(),
                                   left.headers.end(),
-                                  std::bind2nd(MatchFirstWith<Header, std::string>(),
-                                               HTTPHeaderName::ContentType));
+                                  std::bind(MatchFirstWith<Header, std::string>(), std::placeholders::_1,
+                                            std::cref(HTTPHeaderName::ContentType)));
 
             std::string leftContentType;
             if (header != left.headers.end())
@@ -72,8 +72,8 @@ namespace snowcrash {
             // Resolve right content type
             header = std::find_if(right.headers.begin(),
                                   right.headers.end(),
-                                  std::bind2nd(MatchFirstWith<Header, std::string>(),
-                                               HTTPHeaderName::ContentType));
+                                  std::bind(MatchFirstWith<Header, std::string>(), std::placeholders::_1,
+                                            std::cref(HTTPHeaderName::ContentType)));
 
             std::string rightContentType;
             if (header != right.headers.end())
@@ -84,15 +84,15 @@ namespace snowcrash {
     };
     
     /** URI matching predicate. */
-    struct MatchResource : std::binary_function<Resource, Resource, bool> {
-        bool operator()(const first_argument_type& first, const second_argument_type& second) const {
+    struct MatchResource {
+        bool operator()(const Resource& first, const Resource& second) const {
             return first.uriTemplate == second.uriTemplate;
         }
     };
     
     /**  Action matching predicate. */
     template <class T>
-    struct MatchAction : std::binary_function<T, T, bool> {
+    struct MatchAction {
         bool operator()(const T& first, const T& second) const {
             return first.method == second.method;
         }
@@ -107,7 +107,7 @@ namespace snowcrash {
     FORCEINLINE Collection<Request>::const_iterator FindRequest(const TransactionExample& example, const Request& request) {
         return std::find_if(example.requests.begin(),
                             example.requests.end(),
-                            std::bind2nd(MatchPayload(), request));
+                            std::bind(MatchPayload(), std::placeholders::_1, std::cref(request)));
     }
 
     /**
@@ -119,7 +119,7 @@ namespace snowcrash {
     FORCEINLINE Collection<Response>::const_iterator FindResponse(const TransactionExample& example, const Response& response) {
         return std::find_if(example.responses.begin(),
                             example.responses.end(),
-                            std::bind2nd(MatchPayload(), response));
+                            std::bind(MatchPayload(), std::placeholders::_1, std::cref(response)));
     }
 }
 
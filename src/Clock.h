@@ -0,0 +1,24 @@
+//
+//  Clock.h
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#ifndef SNOWCRASH_CLOCK_H
+#define SNOWCRASH_CLOCK_H
+
+#include <cstddef>
+
+namespace snowcrash {
+
+    /**
+     *  \brief  Read a wall-clock time in milliseconds.
+     *
+     *  The time is measured from an unspecified point and wraps
+     *  around, only differences of the readings are meaningful.
+     */
+    size_t ClockMilliseconds();
+}
+
+#endif
@@ -100,21 +100,45 @@ namespace snowcrash {
         }
     }
     
+    /**
+     *  \brief  Append a part of the source data to a description.
+     *
+     *  The appended description is spent from the parser budget. When validating
+     *  only, the description is spent but not retrieved.
+     */
+    template <class T>
+    FORCEINLINE void AppendDescription(const SourceDataBlock& sourceMap,
+                                       BlueprintParserCore& parser,
+                                       T& output) {
+        
+        if (parser.options & ValidateOnlyOption) {
+            parser.budget.spendDescriptionBytes(MapSourceDataLength(parser.sourceData, sourceMap));
+            return;
+        }
+        
+        size_t length = output.description.length();
+        output.description += MapSourceData(parser.sourceData, sourceMap);
+        parser.budget.spendDescriptionBytes(output.description.length() - length);
+    }
+    
     /**
      *  \brief  Process a description block retrieving its content.
      *  \param  section     A section its block is being processed.
      *  \param  cur         Cursor to the block to process.
-     *  \param  sourceData  Source data stream.
+     *  \param  parser      Parser instance.
      *  \param  output      Output object to APPEND retrieved description into.
      *  \return Standard parser section result poinitng at the last block parsed.
+     *
+     *  The description is checked and spent but not retrieved when validating only.
      */
     template <class T>
     FORCEINLINE ParseSectionResult ParseDescriptionBlock(const BlueprintSection& section,
                                                          const BlockIterator& cur,
-                                                         const SourceData& sourceData,
+                                                         BlueprintParserCore& parser,
                                                          T& output) {
         
         ParseSectionResult result = std::make_pair(Result(), cur);
+        const SourceData& sourceData = parser.sourceData;
         BlockIterator sectionCur(cur);
         
         if (sectionCur->type == QuoteBlockBeginType) {
@@ -128,7 +152,7 @@ namespace snowcrash {
             if (sectionCur->type != ListBlockEndType) {
                 // Found recognized lists in the list block
                 if (!descriptionMap.empty())
-                    output.description += MapSourceData(sourceData, descriptionMap);
+                    AppendDescription(descriptionMap, parser, output);
                 
                 result.second = sectionCur;
                 return result;
@@ -146,7 +170,8 @@ namespace snowcrash {
         if (!CheckCursor(section, sectionCur, sourceData, result.first))
             return result;
 
-        output.description += MapSourceData(sourceData, sectionCur->sourceMap);
+        AppendDescription(sectionCur->sourceMap, parser, output);
+        
         result.second = ++sectionCur;
         
         return result;
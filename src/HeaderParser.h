@@ -9,10 +9,12 @@
 #ifndef SNOWCRASH_HEADERPARSER_H
 #define SNOWCRASH_HEADERPARSER_H
 
+#include <set>
 #include <sstream>
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "StringUtility.h"
 #include "ListBlockUtility.h"
 
@@ -33,16 +35,20 @@ namespace snowcrash {
         
         if (begin->type == ListBlockBeginType || begin->type == ListItemBlockBeginType) {
             
-            BlockIterator cur = ListItemNameBlock(begin, end);
-            if (cur == end)
-                return false;
+            int memo = SignatureMemo::Lookup(*begin, SignatureMemo::HeaderEntry);
+            if (memo != SignatureMemo::Unknown)
+                return memo != 0;
             
-            if (cur->type != ParagraphBlockType &&
-                cur->type != ListItemBlockEndType)
-                return false;
+            bool signature = false;
+            BlockIterator cur = ListItemNameBlock(begin, end);
+            if (cur != end &&
+                (cur->type == ParagraphBlockType || cur->type == ListItemBlockEndType)) {
+                
+                MarkdownBlock::Content content = GetFirstLine(cur->content);
+                signature = LexKeywordSignature(content.data(), content.length(), "header", true);
+            }
             
-            std::string content = GetFirstLine(cur->content);
-            return RegexMatch(content, snowcrashconst::HeadersRegex);
+            return SignatureMemo::Store(*begin, SignatureMemo::HeaderEntry, signature) != 0;
         }
         
         return false;
@@ -57,7 +63,7 @@ namespace snowcrash {
         
         return std::find_if(headers.begin(),
                             headers.end(),
-                            std::bind2nd(MatchFirsts<Header>(), header));
+                            std::bind(MatchFirsts<Header>(), std::placeholders::_1, std::cref(header)));
     }
     
     /** Internal list items classifier, Headers Context */
@@ -150,6 +156,10 @@ namespace snowcrash {
                 return result;
             
             // Proces raw data
+            std::set<std::string> keys;
+            for (HeaderIterator it = headers.begin(); it != headers.end(); ++it)
+                keys.insert(it->first);
+            
             std::vector<std::string> lines = Split(data, '\n');
             for (std::vector<std::string>::iterator line = lines.begin();
                  line != lines.end();
@@ -158,7 +168,7 @@ namespace snowcrash {
                 Header header;
                 if (KeyValueFromLine(*line, header)) {
                     
-                    if (FindHeader(headers, header) != headers.end()) {
+                    if (!keys.insert(header.first).second) {
                         // WARN: duplicate header on this level
                         std::stringstream ss;
                         ss << "duplicate definition of '" << header.first << "' header";
@@ -169,7 +179,7 @@ namespace snowcrash {
                         
                     }
                         
-                    headers.push_back(header);
+                    headers.push_back(std::move(header));
                 }
                 else {
                     // WARN: unable to parse header
@@ -273,8 +283,15 @@ namespace snowcrash {
                                const SourceData& sourceData,
                                Result& result) {
         
+        if (left.headers.empty() || right.headers.empty())
+            return;
+        
+        std::set<std::string> leftKeys;
+        for (HeaderIterator it = left.headers.begin(); it != left.headers.end(); ++it)
+            leftKeys.insert(it->first);
+        
         for (HeaderIterator it = right.headers.begin(); it != right.headers.end(); ++it) {
-            if (FindHeader(left.headers, *it) != left.headers.end()) {
+            if (leftKeys.find(it->first) != leftKeys.end()) {
                 // WARN: overshadowing header definition
                 std::stringstream ss;
                 ss << "overshadowing previous '" << it->first << "' header definition";
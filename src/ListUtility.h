@@ -33,7 +33,7 @@ namespace snowcrash {
         if (block.content.empty())
             return result;
         
-        std::string::size_type pos = block.content.find("\n");
+        std::string::size_type pos = block.content.find('\n');
         if (pos == std::string::npos) {
             result.push_back(block.content);
             return result;
@@ -79,16 +79,21 @@ namespace snowcrash {
         if (sectionBegin->type != ListItemBlockBeginType)
             return false;
         
+        int memo = SignatureMemo::Lookup(*sectionBegin, SignatureMemo::NestedListEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
+        
+        bool nested = false;
         BlockIterator sectionEnd = SkipToClosingBlock(sectionBegin,
                                                     end,
                                                     ListItemBlockBeginType,
                                                     ListItemBlockEndType);
-        for (BlockIterator it = sectionBegin; it != sectionEnd; ++it) {
+        for (BlockIterator it = sectionBegin; it != sectionEnd && !nested; ++it) {
             if (it->type == ListBlockBeginType)
-                return true;
+                nested = true;
         }
         
-        return false;
+        return SignatureMemo::Store(*sectionBegin, SignatureMemo::NestedListEntry, nested) != 0;
     }
 }
 
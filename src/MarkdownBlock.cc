@@ -57,6 +57,53 @@ std::string snowcrash::BlockName(const MarkdownBlockType& blockType)
     }
 }
 
+snowcrash::MarkdownBlockType snowcrash::ClosingBlockType(MarkdownBlockType blockType)
+{
+    switch (blockType) {
+        case QuoteBlockBeginType:
+            return QuoteBlockEndType;
+            
+        case ListBlockBeginType:
+            return ListBlockEndType;
+            
+        case ListItemBlockBeginType:
+            return ListItemBlockEndType;
+            
+        default:
+            return UndefinedBlockType;
+    }
+}
+
+void snowcrash::MatchClosingBlocks(MarkdownBlock::Stack& markdown)
+{
+    static const MarkdownBlockType BeginTypes[] = { QuoteBlockBeginType, ListBlockBeginType, ListItemBlockBeginType };
+    static const size_t BeginTypeCount = sizeof(BeginTypes) / sizeof(BeginTypes[0]);
+    
+    // Unmatched begin blocks of each type
+    std::vector<size_t> open[BeginTypeCount];
+    
+    for (size_t i = 0; i < markdown.size(); ++i) {
+        
+        markdown[i].closingOffset = 0;
+        
+        for (size_t t = 0; t < BeginTypeCount; ++t) {
+            
+            if (markdown[i].type == BeginTypes[t]) {
+                open[t].push_back(i);
+                break;
+            }
+            
+            if (markdown[i].type == ClosingBlockType(BeginTypes[t])) {
+                if (!open[t].empty()) {
+                    markdown[open[t].back()].closingOffset = static_cast<int>(i - open[t].back());
+                    open[t].pop_back();
+                }
+                break;
+            }
+        }
+    }
+}
+
 std::string snowcrash::MapSourceData(const SourceData& source, const SourceDataBlock& sourceMap)
 {
     if (source.empty())
@@ -84,6 +131,26 @@ std::string snowcrash::MapSourceData(const SourceData& source, const SourceDataB
     return ss.str();
 }
 
+size_t snowcrash::MapSourceDataLength(const SourceData& source, const SourceDataBlock& sourceMap)
+{
+    size_t length = source.length();
+    size_t mappedLength = 0;
+    for (SourceDataBlock::const_iterator it = sourceMap.begin(); it != sourceMap.end(); ++it) {
+        
+        if (it->location + it->length > length) {
+            // Sundown adds an extra newline on the source input if needed.
+            if (it->location < length)
+                mappedLength += length - it->location;
+            
+            return mappedLength;
+        }
+        
+        mappedLength += it->length;
+    }
+    
+    return mappedLength;
+}
+
 #ifdef DEBUG
 
 #include "Serialize.h"
@@ -11,6 +11,9 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <memory>
+#include <ostream>
 #include "ParserCore.h"
 
 namespace snowcrash {
@@ -38,6 +41,120 @@ namespace snowcrash {
      *  \return Name of the markdown block.
      */
     std::string BlockName(const MarkdownBlockType& blockType);
+    
+    /**
+     *  \return Type of the block closing a block of given type,
+     *          %UndefinedBlockType if the type does not begin a block.
+     */
+    MarkdownBlockType ClosingBlockType(MarkdownBlockType blockType);
+
+    /**
+     *  \brief  Text content of a markdown block.
+     *
+     *  A view (offset, length) into a text buffer shared by all the
+     *  blocks of a parse. Copying the content copies only a reference
+     *  to the buffer, the text is materialized as a string on demand,
+     *  e.g. when it is stored in the blueprint AST.
+     *
+     *  The view is not NUL-terminated, use %data() with %length().
+     */
+    class MarkdownBlockContent {
+    public:
+        /** Text buffer of a parse */
+        typedef std::shared_ptr<const std::string> Buffer;
+
+        MarkdownBlockContent()
+        : m_offset(0), m_length(0) {}
+
+        MarkdownBlockContent(const std::string& text)
+        : m_offset(0), m_length(0) { assign(std::string(text)); }
+
+        MarkdownBlockContent(const char* text)
+        : m_offset(0), m_length(0) { assign(std::string(text)); }
+
+        /** View of a slice of a shared buffer */
+        MarkdownBlockContent(const Buffer& buffer, size_t offset, size_t length)
+        : m_buffer(length ? buffer : Buffer()), m_offset(length ? offset : 0), m_length(length) {}
+
+        /** \return First byte of the content, not NUL-terminated */
+        const char* data() const { return (m_buffer) ? m_buffer->data() + m_offset : ""; }
+
+        size_t length() const { return m_length; }
+        size_t size() const { return m_length; }
+        bool empty() const { return m_length == 0; }
+
+        /** \return The content materialized as a string */
+        std::string str() const { return std::string(data(), m_length); }
+        operator std::string() const { return str(); }
+
+        /** \return Position of the first occurrence of a character at or after pos, `std::string::npos` if none */
+        size_t find(char c, size_t pos = 0) const {
+            for (const char* s = data(); pos < m_length; ++pos)
+                if (s[pos] == c)
+                    return pos;
+            return std::string::npos;
+        }
+
+        /** \return View of a part of the content, sharing its buffer */
+        MarkdownBlockContent substr(size_t pos, size_t n = std::string::npos) const {
+            if (pos > m_length)
+                pos = m_length;
+            if (n > m_length - pos)
+                n = m_length - pos;
+            return MarkdownBlockContent(m_buffer, m_offset + pos, n);
+        }
+
+        void clear() {
+            m_buffer.reset();
+            m_offset = 0;
+            m_length = 0;
+        }
+
+        void swap(MarkdownBlockContent& rhs) {
+            m_buffer.swap(rhs.m_buffer);
+            std::swap(m_offset, rhs.m_offset);
+            std::swap(m_length, rhs.m_length);
+        }
+
+        /** \return True if the content is a view into given buffer */
+        bool sharedWith(const Buffer& buffer) const { return m_buffer && m_buffer == buffer; }
+
+    private:
+        Buffer m_buffer;
+        size_t m_offset;
+        size_t m_length;
+
+        void assign(std::string&& text) {
+            m_length = text.length();
+            if (m_length)
+                m_buffer = std::make_shared<const std::string>(std::move(text));
+        }
+    };
+
+    inline bool operator==(const MarkdownBlockContent& lhs, const MarkdownBlockContent& rhs) {
+        return lhs.length() == rhs.length() && std::equal(lhs.data(), lhs.data() + lhs.length(), rhs.data());
+    }
+
+    inline bool operator==(const MarkdownBlockContent& lhs, const std::string& rhs) {
+        return lhs.length() == rhs.length() && rhs.compare(0, rhs.length(), lhs.data(), lhs.length()) == 0;
+    }
+
+    inline bool operator==(const std::string& lhs, const MarkdownBlockContent& rhs) { return rhs == lhs; }
+    inline bool operator==(const MarkdownBlockContent& lhs, const char* rhs) { return lhs == MarkdownBlockContent(rhs); }
+
+    inline bool operator!=(const MarkdownBlockContent& lhs, const MarkdownBlockContent& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const MarkdownBlockContent& lhs, const std::string& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const std::string& lhs, const MarkdownBlockContent& rhs) { return !(lhs == rhs); }
+    inline bool operator!=(const MarkdownBlockContent& lhs, const char* rhs) { return !(lhs == rhs); }
+
+    inline std::ostream& operator<<(std::ostream& os, const MarkdownBlockContent& content) {
+        return os.write(content.data(), content.length());
+    }
+
+    /** \return View of the first line of a content, without its newline */
+    inline MarkdownBlockContent GetFirstLine(const MarkdownBlockContent& content) {
+        return content.substr(0, content.find('\n'));
+    }
 
     /**
      *  Markdown Block Element
@@ -45,22 +162,32 @@ namespace snowcrash {
     struct MarkdownBlock {
 
         typedef std::vector<MarkdownBlock> Stack;
-        typedef SourceData Content;
+        typedef MarkdownBlockContent Content;
         typedef int Data;
 
         MarkdownBlock()
-        : type(UndefinedBlockType), data(0) {}
+        : type(UndefinedBlockType), data(0), closingOffset(0) {}
         
         MarkdownBlock(MarkdownBlockType t, Content c = Content(), Data d = Data(), SourceDataBlock map = SourceDataBlock())
-        { type = t; content = c; data = d; sourceMap = map; }
+        { type = t; content = c; data = d; closingOffset = 0; sourceMap = map; }
         
         MarkdownBlock(const MarkdownBlock& b)
-        { type = b.type; content = b.content; data = b.data; sourceMap = b.sourceMap; }
+        { type = b.type; content = b.content; data = b.data; closingOffset = b.closingOffset; sourceMap = b.sourceMap; }
         
         virtual ~MarkdownBlock() {}
         
         MarkdownBlock& operator=(const MarkdownBlock& b)
-        { type = b.type; content = b.content; data = b.data; sourceMap = b.sourceMap; return *this; }
+        { type = b.type; content = b.content; data = b.data; closingOffset = b.closingOffset; sourceMap = b.sourceMap; return *this; }
+        
+        /** Exchange contents with other block without copying */
+        void swap(MarkdownBlock& b)
+        {
+            std::swap(type, b.type);
+            content.swap(b.content);
+            std::swap(data, b.data);
+            std::swap(closingOffset, b.closingOffset);
+            sourceMap.swap(b.sourceMap);
+        }
         
         // Type of the Markdown Block
         MarkdownBlockType type;
@@ -71,6 +198,9 @@ namespace snowcrash {
         // Arbitrary data from parser
         Data data;
         
+        // Offset of the matching closing block in the stack, 0 if not matched
+        int closingOffset;
+        
         // Position of this block in source module
         SourceDataBlock sourceMap;
     };
@@ -82,6 +212,22 @@ namespace snowcrash {
      *  \returns A string concatenated from the source string using the byte map.
      */
     std::string MapSourceData(const SourceData& source, const SourceDataBlock& sourceMap);
+    
+    /**
+     *  \brief Length of the data %MapSourceData() would map, without mapping them.
+     */
+    size_t MapSourceDataLength(const SourceData& source, const SourceDataBlock& sourceMap);
+    
+    /**
+     *  \brief  Match begin blocks of a stack with their closing blocks.
+     *
+     *  Records %closingOffset of every begin block that has its
+     *  closing block in the stack. Blocks are matched the very same
+     *  way %SkipToClosingBlock() does, for each block type separately.
+     *
+     *  \param  markdown    A stack to match the blocks of.
+     */
+    void MatchClosingBlocks(MarkdownBlock::Stack& markdown);
         
 #ifdef DEBUG
     // Prints markdown block recursively to stdout
@@ -11,38 +11,58 @@
 
 using namespace snowcrash;
 
-// Returns text from sundown buffer
-static std::string BufText(const struct buf *text)
-{
-    if (!text || !text->data || !text->size)
-        return std::string();
-    
-    return std::string(reinterpret_cast<char *>(text->data), text->size);
-}
-
 const size_t MarkdownParser::OutputUnitSize = 64;
 const size_t MarkdownParser::MaxNesting = 16;
 const int MarkdownParser::ParserExtensions = MKDEXT_FENCED_CODE | MKDEXT_NO_INTRA_EMPHASIS | MKDEXT_LAX_SPACING /*| MKDEXT_TABLES */;
 
+MarkdownParser::MarkdownParser()
+: m_sundown(NULL), m_output(NULL)
+{
+}
+
+MarkdownParser::~MarkdownParser()
+{
+    if (m_output)
+        bufrelease(m_output);
+    
+    if (m_sundown)
+        sd_markdown_free(m_sundown);
+}
+
 void MarkdownParser::parse(const SourceData& source, Result& result, MarkdownBlock::Stack& markdown)
 {
     // Push default render stack
     m_renderStack.clear();
+    m_openQuotes.clear();
+    m_openLists.clear();
+    m_openListItems.clear();
     
-    // Build render callbacks & setup parser
-    RenderCallbacks callbacks = renderCallbacks();
-	sd_markdown *sundown = sd_markdown_new(ParserExtensions, MaxNesting, &callbacks, renderCallbackData());
+    // Release the blocks of a reused stack, reuse the text buffer if no other block refers to it
+    markdown.clear();
+    if (!m_text || m_text.use_count() != 1)
+        m_text = std::make_shared<std::string>();
     
-    buf *output = bufnew(OutputUnitSize);
+    m_text->clear();
+    m_text->reserve(source.length());
+    
+    // Build render callbacks & setup parser, once
+    if (!m_sundown) {
+        RenderCallbacks callbacks = renderCallbacks();
+        m_sundown = sd_markdown_new(ParserExtensions, MaxNesting, &callbacks, renderCallbackData());
+        m_output = bufnew(OutputUnitSize);
+    }
+    
+    m_output->size = 0;
 
     // Parse & build AST
-    sd_markdown_render(output, reinterpret_cast<const uint8_t *>(source.c_str()), source.length(), sundown);
-
-    bufrelease(output);
-    sd_markdown_free(sundown);
+    sd_markdown_render(m_output, reinterpret_cast<const uint8_t *>(source.c_str()), source.length(), m_sundown);
 
-    // Compose final Markdown object
-    markdown = m_renderStack; // FIXME: C++11 move
+    // Compose final Markdown object, handing over the rendered blocks
+    markdown.resize(m_renderStack.size());
+    for (size_t i = 0; i < m_renderStack.size(); ++i)
+        markdown[i].swap(m_renderStack[i]);
+    
+    m_renderStack.clear();
 
 #ifdef DEBUG
     printMarkdown(markdown, 0);
@@ -53,6 +73,13 @@ void MarkdownParser::parse(const SourceData& source, Result& result, MarkdownBlo
 MarkdownParser::RenderCallbacks MarkdownParser::renderCallbacks()
 {
     // Custom callbacks
+    //
+    // AST building only: none of the callbacks renders into its output
+    // buffer, hence no child output is ever concatenated into the text
+    // of its parent block. With no span callbacks inline text is passed
+    // through as it is. The list and quote closing callbacks ignore the
+    // text sundown hands them, it belongs to their nested blocks. Begin
+    // and closing blocks are matched as they are rendered.
     sd_callbacks callbacks;
     ::memset(&callbacks, 0, sizeof(sd_callbacks));
 
@@ -86,18 +113,47 @@ MarkdownParser::RenderCallbackData MarkdownParser::renderCallbackData()
     return this;
 }
 
+void MarkdownParser::pushBlock(MarkdownBlockType type, const struct buf *text, int data)
+{
+    m_renderStack.push_back(MarkdownBlock(type, MarkdownBlock::Content(), data));
+    if (!text || !text->data || !text->size)
+        return;
+    
+    size_t offset = m_text->length();
+    m_text->append(reinterpret_cast<const char *>(text->data), text->size);
+    m_renderStack.back().content = MarkdownBlock::Content(m_text, offset, text->size);
+}
+
+void MarkdownParser::openBlock(OpenBlocks& open, MarkdownBlockType type, int data)
+{
+    open.push_back(m_renderStack.size());
+    pushBlock(type, NULL, data);
+}
+
+void MarkdownParser::closeBlock(OpenBlocks& open, MarkdownBlockType type, const struct buf *text, int data)
+{
+    // Jump table for skipping to closing blocks, see %SkipToClosingBlock()
+    if (!open.empty()) {
+        size_t begin = open.back();
+        open.pop_back();
+        m_renderStack[begin].closingOffset = static_cast<int>(m_renderStack.size() - begin);
+    }
+    
+    pushBlock(type, text, data);
+}
+
 void MarkdownParser::renderHeader(struct buf *ob, const struct buf *text, int level, void *opaque)
 {
     if (!opaque)
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderHeader(BufText(text), level);
+    p->renderHeader(text, level);
 }
 
-void MarkdownParser::renderHeader(const std::string& text, int level)
+void MarkdownParser::renderHeader(const struct buf *text, int level)
 {
-    m_renderStack.push_back(MarkdownBlock(HeaderBlockType, text, level));
+    pushBlock(HeaderBlockType, text, level);
 }
 
 void MarkdownParser::beginList(int flags, void *opaque)
@@ -111,7 +167,7 @@ void MarkdownParser::beginList(int flags, void *opaque)
 
 void MarkdownParser::beginList(int flags)
 {
-    m_renderStack.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), flags));
+    openBlock(m_openLists, ListBlockBeginType, flags);
 }
 
 void MarkdownParser::renderList(struct buf *ob, const struct buf *text, int flags, void *opaque)
@@ -120,12 +176,13 @@ void MarkdownParser::renderList(struct buf *ob, const struct buf *text, int flag
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderList(BufText(text), flags);
+    p->renderList(flags);
 }
 
-void MarkdownParser::renderList(const std::string& text, int flags)
+void MarkdownParser::renderList(int flags)
 {
-    m_renderStack.push_back(MarkdownBlock(ListBlockEndType, text, flags));
+    // List content is in its item blocks
+    closeBlock(m_openLists, ListBlockEndType, NULL, flags);
 }
 
 void MarkdownParser::beginListItem(int flags, void *opaque)
@@ -139,7 +196,7 @@ void MarkdownParser::beginListItem(int flags, void *opaque)
 
 void MarkdownParser::beginListItem(int flags)
 {
-    m_renderStack.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), flags));
+    openBlock(m_openListItems, ListItemBlockBeginType, flags);
 }
 
 void MarkdownParser::renderListItem(struct buf *ob, const struct buf *text, int flags, void *opaque)
@@ -148,12 +205,12 @@ void MarkdownParser::renderListItem(struct buf *ob, const struct buf *text, int
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderListItem(BufText(text), flags);
+    p->renderListItem(text, flags);
 }
 
-void MarkdownParser::renderListItem(const std::string& text, int flags)
+void MarkdownParser::renderListItem(const struct buf *text, int flags)
 {
-    m_renderStack.push_back(MarkdownBlock(ListItemBlockEndType, text, flags));
+    closeBlock(m_openListItems, ListItemBlockEndType, text, flags);
 }
 
 void MarkdownParser::renderBlockCode(struct buf *ob, const struct buf *text, const struct buf *lang, void *opaque)
@@ -162,12 +219,12 @@ void MarkdownParser::renderBlockCode(struct buf *ob, const struct buf *text, con
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderBlockCode(BufText(text), BufText(lang));
+    p->renderBlockCode(text, lang);
 }
 
-void MarkdownParser::renderBlockCode(const std::string& text, const std::string& language)
+void MarkdownParser::renderBlockCode(const struct buf *text, const struct buf *language)
 {
-    m_renderStack.push_back(MarkdownBlock(CodeBlockType, text));
+    pushBlock(CodeBlockType, text);
 }
 
 void MarkdownParser::renderParagraph(struct buf *ob, const struct buf *text, void *opaque)
@@ -176,12 +233,12 @@ void MarkdownParser::renderParagraph(struct buf *ob, const struct buf *text, voi
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderParagraph(BufText(text));
+    p->renderParagraph(text);
 }
 
-void MarkdownParser::renderParagraph(const std::string& text)
+void MarkdownParser::renderParagraph(const struct buf *text)
 {
-    m_renderStack.push_back(MarkdownBlock(ParagraphBlockType, text));
+    pushBlock(ParagraphBlockType, text);
 }
 
 void MarkdownParser::renderHorizontalRule(struct buf *ob, void *opaque)
@@ -195,7 +252,7 @@ void MarkdownParser::renderHorizontalRule(struct buf *ob, void *opaque)
 
 void MarkdownParser::renderHorizontalRule()
 {
-    m_renderStack.push_back(MarkdownBlock(HRuleBlockType));
+    pushBlock(HRuleBlockType);
 }
 
 void MarkdownParser::renderHTML(struct buf *ob, const struct buf *text, void *opaque)
@@ -204,12 +261,12 @@ void MarkdownParser::renderHTML(struct buf *ob, const struct buf *text, void *op
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderHTML(BufText(text));
+    p->renderHTML(text);
 }
 
-void MarkdownParser::renderHTML(const std::string& text)
+void MarkdownParser::renderHTML(const struct buf *text)
 {
-    m_renderStack.push_back(MarkdownBlock(HTMLBlockType, text));
+    pushBlock(HTMLBlockType, text);
 }
 
 void MarkdownParser::beginQuote(void *opaque)
@@ -223,7 +280,7 @@ void MarkdownParser::beginQuote(void *opaque)
 
 void MarkdownParser::beginQuote()
 {
-    m_renderStack.push_back(MarkdownBlock(QuoteBlockBeginType, SourceData(), 0));
+    openBlock(m_openQuotes, QuoteBlockBeginType);
 }
 
 void MarkdownParser::renderQuote(struct buf *ob, const struct buf *text, void *opaque)
@@ -232,12 +289,13 @@ void MarkdownParser::renderQuote(struct buf *ob, const struct buf *text, void *o
         return;
     
     MarkdownParser *p = static_cast<MarkdownParser *>(opaque);
-    p->renderQuote(BufText(text));
+    p->renderQuote();
 }
 
-void MarkdownParser::renderQuote(const std::string& text)
+void MarkdownParser::renderQuote()
 {
-    m_renderStack.push_back(MarkdownBlock(QuoteBlockEndType, text, 0));
+    // Quote content is in its nested blocks
+    closeBlock(m_openQuotes, QuoteBlockEndType);
 }
 
 void MarkdownParser::blockDidParse(const src_map* map, const uint8_t *txt_data, size_t size, void *opaque)
@@ -9,6 +9,9 @@
 #ifndef SNOWCRASH_MARKDOWNPARSER_H
 #define SNOWCRASH_MARKDOWNPARSER_H
 
+#include <deque>
+#include <memory>
+#include <vector>
 #include "ParserCore.h"
 #include "SourceAnnotation.h"
 #include "MarkdownBlock.h"
@@ -26,43 +29,85 @@ namespace snowcrash {
         static const size_t MaxNesting;// = 16;
         static const int ParserExtensions;// = MKDEXT_FENCED_CODE | MKDEXT_NO_INTRA_EMPHASIS /*| MKDEXT_TABLES */;
         
+        MarkdownParser();
+        ~MarkdownParser();
+        
         // Parse source Markdown into Markdown AST
+        // The sundown instance is created once and reused by subsequent parses
         void parse(const SourceData& source, Result& result, MarkdownBlock::Stack& markdown);
     
     private:
+        MarkdownParser(const MarkdownParser&);
+        MarkdownParser& operator=(const MarkdownParser&);
+        
+        sd_markdown *m_sundown;
+        buf *m_output;
+        
         typedef sd_callbacks RenderCallbacks;
         typedef void * RenderCallbackData;
     
         RenderCallbacks renderCallbacks();
         RenderCallbackData renderCallbackData();
         
-        MarkdownBlock::Stack m_renderStack;
+        /**
+         *  Blocks being rendered. Unlike the vector the deque never
+         *  relocates its blocks as it grows, every block is handed over
+         *  to the final stack by swap.
+         */
+        typedef std::deque<MarkdownBlock> RenderStack;
+        RenderStack m_renderStack;
+        
+        /**
+         *  Text of the blocks of a parse. The block contents are views
+         *  into the buffer, it is reused by the next parse unless a block
+         *  of the previous parse still refers to it.
+         */
+        std::shared_ptr<std::string> m_text;
+        
+        /**
+         *  Positions of the begin blocks still open, for each block type.
+         *  The closing callback records the offset of its block into the
+         *  matching begin block, no post-pass is needed.
+         */
+        typedef std::vector<size_t> OpenBlocks;
+        OpenBlocks m_openQuotes;
+        OpenBlocks m_openLists;
+        OpenBlocks m_openListItems;
+        
+        // Push a block, appending its content from a sundown buffer to the text buffer
+        void pushBlock(MarkdownBlockType type, const struct buf *text = NULL, int data = 0);
+        
+        // Push a begin block, keep it open
+        void openBlock(OpenBlocks& open, MarkdownBlockType type, int data = 0);
+        
+        // Push a closing block, record its offset in the last open begin block
+        void closeBlock(OpenBlocks& open, MarkdownBlockType type, const struct buf *text = NULL, int data = 0);
         
         // Header
         static void renderHeader(struct buf *ob, const struct buf *text, int level, void *opaque);
-        void renderHeader(const std::string& text, int level);
+        void renderHeader(const struct buf *text, int level);
         
         // List
         static void beginList(int flags, void *opaque);
         void beginList(int flags);
         
         static void renderList(struct buf *ob, const struct buf *text, int flags, void *opaque);
-        void renderList(const std::string& text, int flags);
+        void renderList(int flags);
         
         // List item
         static void beginListItem(int flags, void *opaque);
         void beginListItem(int flags);
         
         static void renderListItem(struct buf *ob, const struct buf *text, int flags, void *opaque);
-        void renderListItem(const std::string& text, int flags);
+        void renderListItem(const struct buf *text, int flags);
         
         // Code block
         static void renderBlockCode(struct buf *ob, const struct buf *text, const struct buf *lang, void *opaque);
-        void renderBlockCode(const std::string& text, const std::string& language);
+        void renderBlockCode(const struct buf *text, const struct buf *language);
         
         // Paragraph
         static void renderParagraph(struct buf *ob, const struct buf *text, void *opaque);
-        void renderParagraph(const std::string& text);
+        void renderParagraph(const struct buf *text);
         
         // Horizontal Rule
         static void renderHorizontalRule(struct buf *ob, void *opaque);
@@ -70,14 +115,14 @@ namespace snowcrash {
 
         // HTML
         static void renderHTML(struct buf *ob, const struct buf *text, void *opaque);
-        void renderHTML(const std::string& text);
+        void renderHTML(const struct buf *text);
     
         // Quote
         static void beginQuote(void *opaque);
         void beginQuote();
     
         static void renderQuote(struct buf *ob, const struct buf *text, void *opaque);
-        void renderQuote(const std::string& text);
+        void renderQuote();
         
         // Source maps
         static void blockDidParse(const src_map* map, const uint8_t *txt_data, size_t size, void *opaque);
@@ -13,6 +13,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "StringUtility.h"
 #include "ListBlockUtility.h"
 #include "SectionUtility.h"
@@ -74,7 +75,7 @@ namespace snowcrash {
         
         content = TrimString(content);
         
-        if (RegexMatch(content, snowcrashconst::ParameterValuesRegex))
+        if (LexKeywordSignature(content, "values"))
             return ParameterValuesSectionType;
         
         return UndefinedSectionType;
@@ -102,19 +103,24 @@ namespace snowcrash {
             begin->type != ListItemBlockBeginType)
             return false;
         
-        // Since we are too generic make sure the signature is not inner list
-        SectionType listSection = ClassifyInternaListBlock<Parameter>(begin, end);
-        if (listSection != UndefinedSectionType)
-            return false;
+        int memo = SignatureMemo::Lookup(*begin, SignatureMemo::ParameterDefinitionEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
         
-        // Or any other reserved keyword
-        if (HasParametersSignature(begin, end))
-            return false;
+        bool signature = false;
         
-        SourceData remainingContent;
-        SourceData content = GetListItemSignature(begin, end, remainingContent);
-        content = TrimString(content);
-        return RegexMatch(content, snowcrashconst::ParameterAbbrevDefinitionRegex);
+        // Since we are too generic make sure the signature is not inner list
+        // or any other reserved keyword
+        if (ClassifyInternaListBlock<Parameter>(begin, end) == UndefinedSectionType &&
+            !HasParametersSignature(begin, end)) {
+            
+            SourceData remainingContent;
+            SourceData content = GetListItemSignature(begin, end, remainingContent);
+            content = TrimString(content);
+            signature = RegexMatch(content, snowcrashconst::ParameterAbbrevDefinitionRegex);
+        }
+        
+        return SignatureMemo::Store(*begin, SignatureMemo::ParameterDefinitionEntry, signature) != 0;
     }
     
     /**
@@ -225,7 +231,7 @@ namespace snowcrash {
             // Description
             result = ParseDescriptionBlock<Parameter>(section,
                                                        sectionCur,
-                                                       parser.sourceData,
+                                                       parser,
                                                        parameter);
             return result;
             
@@ -249,25 +255,24 @@ namespace snowcrash {
             SourceData signature = GetListItemSignature(cur, section.bounds.second, remainingContent);
 
             TrimString(signature);
-            CaptureGroups captureGroups;
-            if (RegexCapture(signature, snowcrashconst::ParameterAbbrevDefinitionRegex, captureGroups) &&
-                captureGroups.size() == 8) {
+            CaptureRanges captureRanges;
+            if (RegexCaptureRanges(signature, snowcrashconst::ParameterAbbrevDefinitionRegex, captureRanges, 8)) {
                 
                 // Name
-                parameter.name = captureGroups[1];
+                parameter.name = CaptureRangeString(signature, captureRanges[1]);
                 TrimString(parameter.name);
                 
                 // Default value
-                if (!captureGroups[3].empty())
-                    parameter.defaultValue = captureGroups[3];
+                if (captureRanges[3].length)
+                    parameter.defaultValue = CaptureRangeString(signature, captureRanges[3]);
                 
                 // Additional Attributes
-                if (!captureGroups[5].empty())
-                    ProcessSignatureAdditionalTraits(section, cur, captureGroups[5], sourceData, result, parameter);
+                if (captureRanges[5].length)
+                    ProcessSignatureAdditionalTraits(section, cur, CaptureRangeString(signature, captureRanges[5]), sourceData, result, parameter);
                 
                 // Description
-                if (!captureGroups[7].empty())
-                    parameter.description = captureGroups[7];
+                if (captureRanges[7].length)
+                    parameter.description = CaptureRangeString(signature, captureRanges[7]);
                 
                 if (!remainingContent.empty()) {
                     parameter.description += "\n";
@@ -314,38 +319,27 @@ namespace snowcrash {
             // Cherry pick example value, if any
             std::string source = additionalTraits;
             TrimString(source);
-            CaptureGroups captureGroups;
-            if (RegexCapture(source, snowcrashconst::AdditionalTraitsExampleRegex, captureGroups) &&
-                captureGroups.size() > 1) {
+            CaptureRanges captureRanges;
+            if (RegexCaptureRanges(source, snowcrashconst::AdditionalTraitsExampleRegex, captureRanges, 2)) {
                 
-                parameter.exampleValue = captureGroups[1];
-                std::string::size_type pos = source.find(captureGroups[0]);
-                if (pos != std::string::npos)
-                    source.replace(pos, captureGroups[0].length(), std::string());
+                parameter.exampleValue = CaptureRangeString(source, captureRanges[1]);
+                source.erase(captureRanges[0].location, captureRanges[0].length);
             }
             
             // Cherry pick use attribute, if any
-            captureGroups.clear();
-            if (RegexCapture(source, snowcrashconst::AdditionalTraitsUseRegex, captureGroups) &&
-                captureGroups.size() > 1) {
+            if (RegexCaptureRanges(source, snowcrashconst::AdditionalTraitsUseRegex, captureRanges, 2)) {
                 
-                parameter.use = (RegexMatch(captureGroups[1], snowcrashconst::ParameterOptionalRegex)) ? OptionalParameterUse : RequiredParameterUse;
-
-                std::string::size_type pos = source.find(captureGroups[0]);
-                if (pos != std::string::npos)
-                    source.replace(pos, captureGroups[0].length(), std::string());
+                // Either [Oo]ptional or [Rr]equired
+                char use = source[captureRanges[1].location];
+                parameter.use = (use == 'O' || use == 'o') ? OptionalParameterUse : RequiredParameterUse;
+                source.erase(captureRanges[0].location, captureRanges[0].length);
             }
             
             // Finish with type
-            captureGroups.clear();
-            if (RegexCapture(source, snowcrashconst::AdditionalTraitsTypeRegex, captureGroups) &&
-                captureGroups.size() > 1) {
-                
-                parameter.type = captureGroups[1];
+            if (RegexCaptureRanges(source, snowcrashconst::AdditionalTraitsTypeRegex, captureRanges, 2)) {
                 
-                std::string::size_type pos = source.find(captureGroups[0]);
-                if (pos != std::string::npos)
-                    source.replace(pos, captureGroups[0].length(), std::string());
+                parameter.type = CaptureRangeString(source, captureRanges[1]);
+                source.erase(captureRanges[0].location, captureRanges[0].length);
             }
             
             // Check whats left
@@ -490,16 +484,15 @@ namespace snowcrash {
                 
                 sectionCur = SkipToClosingBlock(sectionCur, bounds.second, ListItemBlockBeginType, ListItemBlockEndType);
                 
-                CaptureGroups captureGroups;
+                CaptureRanges captureRanges;
                 std::string content = sectionCur->content;
                 if (content.empty()) {
                     // Not inline list, map from source
                     content = MapSourceData(parser.sourceData, sectionCur->sourceMap);
                 }
 
-                RegexCapture(content, PARAMETER_VALUE, captureGroups);
-                if (captureGroups.size() > 1) {
-                    values.push_back(captureGroups[1]);
+                if (RegexCaptureRanges(content, PARAMETER_VALUE, captureRanges, 2)) {
+                    values.push_back(CaptureRangeString(content, captureRanges[1]));
                 }
                 else {
                     // WARN: Ignoring unexpected content
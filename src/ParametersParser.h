@@ -13,6 +13,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "StringUtility.h"
 #include "BlockUtility.h"
 #include "ParameterDefinitonParser.h"
@@ -40,7 +41,7 @@ namespace snowcrash {
                                                            const Parameter& parameter) {
         return std::find_if(parameters.begin(),
                             parameters.end(),
-                            std::bind2nd(MatchName<Parameter>(), parameter));
+                            std::bind(MatchName<Parameter>(), std::placeholders::_1, std::cref(parameter)));
     }
     
     /**
@@ -53,10 +54,15 @@ namespace snowcrash {
             begin->type != ListItemBlockBeginType)
             return false;
         
+        int memo = SignatureMemo::Lookup(*begin, SignatureMemo::ParametersEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
+        
         SourceData remainingContent;
         SourceData content = GetListItemSignature(begin, end, remainingContent);
         TrimString(content);
-        return RegexMatch(content, snowcrashconst::ParametersRegex);
+        bool signature = LexKeywordSignature(content, "parameter", true);
+        return SignatureMemo::Store(*begin, SignatureMemo::ParametersEntry, signature) != 0;
     }
     
     /** Children List Block Classifier, ParameterCollection context. */
@@ -239,7 +245,7 @@ namespace snowcrash {
                 }
             }
             
-            parameters.push_back(parameter);
+            parameters.push_back(std::move(parameter));
             
             return result;
         }
@@ -18,13 +18,15 @@ const int SourceAnnotation::OK = 0;
 
 // Check source for unsupported character \t & \r
 // Returns true if passed (not found), false otherwise
-static bool CheckSource(const SourceData& source, Result& result)
+static bool CheckSource(const SourceData& source, BlueprintParserOptions options, Result& result)
 {
+    bool skipSourceMap = (options & SkipSourceMapOption) != 0;
+    
     std::string::size_type pos = source.find("\t");
     if (pos != std::string::npos) {
         result.error = Error("the use of tab(s) '\\t' in source data isn't currently supported, please contact makers",
                              2,
-                             MapSourceDataBlock(MakeSourceDataBlock(pos, 1), source));
+                             (skipSourceMap) ? SourceCharactersBlock() : MapSourceDataBlock(MakeSourceDataBlock(pos, 1), source));
         return false;
     }
 
@@ -32,31 +34,86 @@ static bool CheckSource(const SourceData& source, Result& result)
     if (pos != std::string::npos) {
         result.error = Error("the use of carriage return(s) '\\r' in source data isn't currently supported, please contact makers",
                              2,
-                             MapSourceDataBlock(MakeSourceDataBlock(pos, 1), source));
+                             (skipSourceMap) ? SourceCharactersBlock() : MapSourceDataBlock(MakeSourceDataBlock(pos, 1), source));
         return false;
     }
     
     return true;
 }
 
+ParserContext::ParserContext()
+: m_markdownParser(::new MarkdownParser), m_warningCallback(NULL), m_warningCallbackData(NULL), m_symbolIndex(NULL)
+{
+}
+
+ParserContext::~ParserContext()
+{
+    ::delete m_markdownParser;
+}
+
+void ParserContext::setWarningCallback(WarningCallback callback, void* data)
+{
+    m_warningCallback = callback;
+    m_warningCallbackData = data;
+}
+
+void ParserContext::setBudget(const ParserBudget& budget)
+{
+    m_budget = budget;
+}
+
+void ParserContext::setSymbolIndex(SymbolIndex* symbolIndex)
+{
+    m_symbolIndex = symbolIndex;
+}
+
 void Parser::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint)
 {
+    ParserContext context;
+    parse(source, options, result, blueprint, context);
+}
+
+void Parser::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint, ParserContext& context)
+{
+    // Release blocks of this parse, keep the buffer for the next one
+    struct MarkdownRelease {
+        MarkdownBlock::Stack& markdown;
+        ~MarkdownRelease() { markdown.clear(); }
+    } markdownRelease = { context.m_markdown };
+    
     try {
         
         // Sanity Check
-        if (!CheckSource(source, result))
+        if (!CheckSource(source, options, result))
             return;
         
         // Parse Markdown
-        MarkdownBlock::Stack markdown;
-        MarkdownParser markdownParser;
-        markdownParser.parse(source, result, markdown);
+        size_t start = ClockMilliseconds();
+        MarkdownBlock::Stack& markdown = context.m_markdown;
+        context.m_markdownParser->parse(source, result, markdown);
         
         if (result.error.code != Error::OK)
             return;
         
+        // The blueprint parser spends what is left of the time
+        ParserBudget budget = context.m_budget;
+        if (budget.maxTime) {
+            size_t elapsed = ClockMilliseconds() - start;
+            if (elapsed >= budget.maxTime) {
+                
+                std::stringstream ss;
+                ss << "exceeded the parser budget of " << budget.maxTime << " ms";
+                result.error = Error(ss.str(), BudgetError);
+                return;
+            }
+            
+            budget.maxTime -= elapsed;
+        }
+        
         // Parse Blueprint
-        BlueprintParser::Parse(source, markdown, options, result, blueprint);
+        BlueprintParser::Parse(source, markdown, options, result, blueprint,
+                               context.m_warningCallback, context.m_warningCallbackData,
+                               budget, context.m_symbolIndex);
     }
     catch (const std::exception& e) {
 
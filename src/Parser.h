@@ -15,6 +15,48 @@
 
 namespace snowcrash {
     
+    class MarkdownParser;
+    
+    /**
+     *  \brief  Reusable parser state.
+     *
+     *  Keeps the markdown parser (and its sundown instance) and the
+     *  markdown block buffer warm across the parses to save their
+     *  setup when parsing many documents. A context must not be used
+     *  by more than one thread at a time.
+     *
+     *  A context can also stream the warnings of its parses to a
+     *  callback as they are found, the warnings are reported in the
+     *  parsing result as well.
+     */
+    class ParserContext {
+    public:
+        ParserContext();
+        ~ParserContext();
+        
+        /** Set the callback invoked with every warning found, NULL for none */
+        void setWarningCallback(WarningCallback callback, void* data = NULL);
+        
+        /** Set the limits of every parse, see %ParserBudget */
+        void setBudget(const ParserBudget& budget);
+        
+        /** Set the index to fill with the model symbols of every parse, NULL for none */
+        void setSymbolIndex(SymbolIndex* symbolIndex);
+        
+    private:
+        friend class Parser;
+        
+        MarkdownParser* m_markdownParser;
+        MarkdownBlock::Stack m_markdown;
+        WarningCallback m_warningCallback;
+        void* m_warningCallbackData;
+        ParserBudget m_budget;
+        SymbolIndex* m_symbolIndex;
+        
+        ParserContext(const ParserContext&);
+        ParserContext& operator=(const ParserContext&);
+    };
+    
     //
     // API Blueprint Parser
     //
@@ -23,6 +65,9 @@ namespace snowcrash {
         
         // Parse source data into Blueprint AST
         void parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint);
+        
+        // Parse source data into Blueprint AST reusing given context
+        void parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint, ParserContext& context);
     };
 }
 
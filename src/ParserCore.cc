@@ -6,7 +6,10 @@
 //  Copyright (c) 2013 Apiary Inc. All rights reserved.
 //
 
+#include <algorithm>
+#include <cstring>
 #include "ParserCore.h"
+#include "UTF8.h"
 
 using namespace snowcrash;
 
@@ -32,7 +35,7 @@ void snowcrash::AppendSourceDataBlock(SourceDataBlock& destination, const Source
         destination.back().length += append.front().length;
         
         if (append.size() > 1) {
-            destination.insert(destination.end(), ++append.begin(), append.end());
+            destination.insert(destination.end(), append.begin() + 1, append.end());
         }
     }
 }
@@ -68,32 +71,35 @@ SourceDataBlockPair snowcrash::SplitSourceDataBlock(const SourceDataBlock& block
             right.location += remain;
             right.length -= remain;
             second.push_back(right);
+            
+            remain = 0;
         }
     }
     
     return std::make_pair(first, second);
 }
 
-#define UTF8_CHAR_LEN( byte ) (( 0xE5000000 >> (( byte >> 3 ) & 0x1e )) & 3 ) + 1
-
-/** \returns Number of UTF8 characters in byte buffer */
+/** \returns Number of UTF8 characters in byte buffer, up to the first NUL */
 static size_t strnlen_utf8(const char* s, size_t len)
 {
     if (!s || !len)
         return 0;
     
-    size_t i = 0, j = 0;
-	while (s[i] && i < len) {
-        i += UTF8_CHAR_LEN(s[i]);
-        j++;
-	}
-	return j;
+    const void* nul = ::memchr(s, '\0', len);
+    if (nul)
+        len = static_cast<const char*>(nul) - s;
+    
+    return CountUTF8Characters(s, len);
 }
 
 SourceCharactersRange snowcrash::MapSourceDataRange(const SourceDataRange& range, const SourceData& data)
 {
-    if (data.empty())
+    if (data.empty() || SourceCharacterIndex::IsMappingSkipped(data))
         return SourceCharactersRange();
+
+    const SourceCharacterIndex* index = SourceCharacterIndex::Active(data);
+    if (index)
+        return index->mapRange(range);
     
     size_t charLocation = 0;
     if (range.location > 0)
@@ -111,6 +117,9 @@ SourceCharactersBlock snowcrash::MapSourceDataBlock(const SourceDataBlock& block
 {
     SourceCharactersBlock characterMap;
     
+    if (SourceCharacterIndex::IsMappingSkipped(data))
+        return characterMap;
+    
     for (SourceDataBlock::const_iterator it = block.begin(); it != block.end(); ++it) {
         SourceCharactersRange characterRange = MapSourceDataRange(*it, data);
         characterMap.push_back(characterRange);
@@ -118,3 +127,118 @@ SourceCharactersBlock snowcrash::MapSourceDataBlock(const SourceDataBlock& block
         
     return characterMap;
 }
+
+/** Index active in the current thread */
+static THREADLOCAL const SourceCharacterIndex* ActiveSourceCharacterIndex = NULL;
+
+/** Mapping of the active index buffer is skipped */
+static THREADLOCAL bool ActiveSkipMapping = false;
+
+SourceCharacterIndex::SourceCharacterIndex(const SourceData& data)
+: m_data(data), m_built(false), m_end(0)
+{
+}
+
+SourceCharacterIndex::Scope::Scope(const SourceCharacterIndex& index, bool skipMapping)
+: m_previous(ActiveSourceCharacterIndex), m_previousSkipMapping(ActiveSkipMapping)
+{
+    ActiveSourceCharacterIndex = &index;
+    ActiveSkipMapping = skipMapping;
+}
+
+SourceCharacterIndex::Scope::~Scope()
+{
+    ActiveSourceCharacterIndex = m_previous;
+    ActiveSkipMapping = m_previousSkipMapping;
+}
+
+const SourceCharacterIndex* SourceCharacterIndex::Active(const SourceData& data)
+{
+    if (!ActiveSourceCharacterIndex || &ActiveSourceCharacterIndex->m_data != &data)
+        return NULL;
+
+    return ActiveSourceCharacterIndex;
+}
+
+bool SourceCharacterIndex::IsMappingSkipped(const SourceData& data)
+{
+    return ActiveSkipMapping && Active(data) != NULL;
+}
+
+void SourceCharacterIndex::build() const
+{
+    if (m_built)
+        return;
+
+    const char* s = m_data.c_str();
+    size_t len = m_data.length();
+
+    // Count the characters the very same way as strnlen_utf8()
+    const void* nul = ::memchr(s, '\0', len);
+    m_end = (nul) ? static_cast<const char*>(nul) - s : len;
+
+    m_checkpoints.clear();
+    m_checkpoints.reserve(m_end / CheckpointInterval + 1);
+    m_checkpoints.push_back(0);
+
+    for (size_t i = CheckpointInterval; i <= m_end; i += CheckpointInterval)
+        m_checkpoints.push_back(m_checkpoints.back() + CountUTF8Characters(s + i - CheckpointInterval, CheckpointInterval));
+
+    // Newline is never a part of a multi-byte character
+    m_lineStarts.assign(1, 0);
+
+    size_t location = 0, characters = 0;
+    const void* newline;
+    while ((newline = ::memchr(s + location, '\n', m_end - location)) != NULL) {
+        size_t next = static_cast<const char*>(newline) - s + 1;
+        characters += CountUTF8Characters(s + location, next - location);
+        m_lineStarts.push_back(characters);
+        location = next;
+    }
+
+    m_built = true;
+}
+
+size_t SourceCharacterIndex::characterLocation(size_t byteLocation) const
+{
+    build();
+
+    if (byteLocation > m_end)
+        byteLocation = m_end;
+
+    size_t checkpoint = byteLocation / CheckpointInterval;
+    size_t checkpointLocation = checkpoint * CheckpointInterval;
+
+    return m_checkpoints[checkpoint] + CountUTF8Characters(m_data.c_str() + checkpointLocation,
+                                                           byteLocation - checkpointLocation);
+}
+
+SourceCharactersRange SourceCharacterIndex::mapRange(const SourceDataRange& range) const
+{
+    if (m_data.empty())
+        return SourceCharactersRange();
+
+    size_t charLocation = 0;
+    if (range.location > 0)
+        charLocation = characterLocation(range.location);
+
+    size_t charLength = 0;
+    if (range.length > 0)
+        charLength = strnlen_utf8(m_data.c_str() + range.location, range.length);
+
+    SourceCharactersRange characterRange = {charLocation, charLength };
+    return characterRange;
+}
+
+void SourceCharacterIndex::lineColumn(size_t characterLocation, size_t& line, size_t& column) const
+{
+    build();
+
+    std::vector<size_t>::const_iterator it = std::upper_bound(m_lineStarts.begin(),
+                                                              m_lineStarts.end(),
+                                                              characterLocation);
+    --it;   // the first line starts at 0
+
+    line = static_cast<size_t>(it - m_lineStarts.begin()) + 1;
+    column = characterLocation - *it + 1;
+}
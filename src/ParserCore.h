@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include "SourceAnnotation.h"
+#include "SmallVector.h"
 #include "Platform.h"
 
 namespace snowcrash {
@@ -36,8 +37,11 @@ namespace snowcrash {
      * 
      *  NOTE: The block does not have to be continuous.
      *  Data Blocks are in bytes not characters.
+     *
+     *  Most of the blocks consist of one or two ranges,
+     *  these are held inline without an allocation.
      */
-    typedef std::vector<SourceDataRange> SourceDataBlock;
+    typedef SmallVector<SourceDataRange, 2> SourceDataBlock;
     
     /**
      *  \brief  Create a %SourceDataBlock with a range.
@@ -77,6 +81,100 @@ namespace snowcrash {
      *  \returns A character-map constructed from given byte map
      */
     SourceCharactersBlock MapSourceDataBlock(const SourceDataBlock& block, const SourceData& data);
+
+    /**
+     *  \brief  Index of UTF-8 characters in a source data buffer.
+     *
+     *  Holds the number of characters preceding fixed byte intervals
+     *  of the buffer and character locations of the line starts. With
+     *  the index a byte location maps to a character location without
+     *  counting the characters from the start of the buffer, a character
+     *  location maps to a line and column in a logarithmic time.
+     *
+     *  As %MapSourceDataRange(), characters are counted up to the first
+     *  NUL byte of the buffer.
+     *
+     *  The index is built on its first query. The indexed buffer must
+     *  not be modified for the lifetime of the index.
+     *
+     *  %MapSourceDataRange() and %MapSourceDataBlock() use the index
+     *  when it is activated for their buffer with a
+     *  %SourceCharacterIndex::Scope. A scope can skip the mapping
+     *  altogether, the functions then map to empty characters ranges.
+     *  The parser reuses an index active for the source it parses.
+     */
+    class SourceCharacterIndex {
+    public:
+
+        /** Byte interval of the character count checkpoints */
+        static const size_t CheckpointInterval = 128;
+
+        explicit SourceCharacterIndex(const SourceData& data);
+
+        /**
+         *  \brief  Activates an index for the lifetime of the scope.
+         *
+         *  The previously active index is restored when the scope ends.
+         *
+         *  \param  index       An index to activate.
+         *  \param  skipMapping True to skip mapping of the index buffer.
+         */
+        class Scope {
+        public:
+            explicit Scope(const SourceCharacterIndex& index, bool skipMapping = false);
+            ~Scope();
+
+        private:
+            const SourceCharacterIndex* m_previous;
+            bool m_previousSkipMapping;
+
+            Scope();
+            Scope(const Scope&);
+            Scope& operator=(const Scope&);
+        };
+
+        /** \return The index active in the current thread for a buffer, NULL if none */
+        static const SourceCharacterIndex* Active(const SourceData& data);
+
+        /** \return True if mapping of a buffer is skipped in the current thread */
+        static bool IsMappingSkipped(const SourceData& data);
+
+        /** \return The indexed buffer */
+        const SourceData& data() const { return m_data; }
+
+        /** \return Number of characters preceding a byte location, see %CountUTF8Characters() */
+        size_t characterLocation(size_t byteLocation) const;
+
+        /** \brief Maps range of source data bytes into range of characters */
+        SourceCharactersRange mapRange(const SourceDataRange& range) const;
+
+        /**
+         *  \brief  Maps a character location to its line and column.
+         *  \param  characterLocation   A character location to map.
+         *  \param  line    Line of the location, starting at 1.
+         *  \param  column  Column of the location, starting at 1.
+         */
+        void lineColumn(size_t characterLocation, size_t& line, size_t& column) const;
+
+        /**
+         *  \brief Builds the index unless it is built already.
+         *
+         *  A built index can be queried from more threads at once.
+         */
+        void build() const;
+
+    private:
+        const SourceData& m_data;
+
+        mutable bool m_built;
+        mutable size_t m_end;                       /// < Byte location where the character counting stops
+        mutable std::vector<size_t> m_checkpoints;  /// < Number of characters preceding each interval
+        mutable std::vector<size_t> m_lineStarts;   /// < Character locations of the line starts
+
+        SourceCharacterIndex();
+        SourceCharacterIndex(const SourceCharacterIndex&);
+        SourceCharacterIndex& operator=(const SourceCharacterIndex&);
+    };
 }
 
 #endif
@@ -14,6 +14,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "AssetParser.h"
 #include "HeaderParser.h"
 #include "DescriptionSectionUtility.h"
@@ -75,47 +76,70 @@ namespace snowcrash {
                 cur->type != ListItemBlockEndType)
                 return NoPayloadSignature;
             
-            std::string content = GetFirstLine(cur->content);
+            MarkdownBlock::Content content = GetFirstLine(cur->content);
             
-            CaptureGroups captureGroups;
-            if (RegexCapture(content, snowcrashconst::RequestRegex, captureGroups, 5)) {
-                name = captureGroups[1];
-                TrimString(name);
-                mediaType = captureGroups[3];
-                return RequestPayloadSignature;
-            }
-            else if (RegexCapture(content, snowcrashconst::ResponseRegex, captureGroups, 5)) {
-                name = captureGroups[1];
-                TrimString(name);
-                mediaType = captureGroups[3];
-                return ResponsePayloadSignature;
-            }
-            else if (RegexCapture(content, snowcrashconst::ObjectRegex, captureGroups, 5)) {
-                name = captureGroups[1];
-                TrimString(name);
-                mediaType = captureGroups[3];
-                return ObjectPayloadSignature;
-            }
-            else if (RegexCapture(content, snowcrashconst::ModelRegex, captureGroups, 5)) {
-                name = captureGroups[1];
-                TrimString(name);
-                mediaType = captureGroups[3];
-                return ModelPayloadSignature;
+            PayloadSignature signature = NoPayloadSignature;
+            SignatureToken nameToken, mediaTypeToken;
+            switch (LexPayloadSignature(content.data(), content.length(), nameToken, mediaTypeToken)) {
+                case RequestPayloadKeyword:
+                    signature = RequestPayloadSignature;
+                    break;
+                    
+                case ResponsePayloadKeyword:
+                    signature = ResponsePayloadSignature;
+                    break;
+                    
+                case ObjectPayloadKeyword:
+                    signature = ObjectPayloadSignature;
+                    break;
+                    
+                case ModelPayloadKeyword:
+                    signature = ModelPayloadSignature;
+                    break;
+                    
+                default:
+                    return NoPayloadSignature;
             }
+            
+            name = SignatureTokenString(content.data(), nameToken);
+            TrimString(name);
+            mediaType = SignatureTokenString(content.data(), mediaTypeToken);
+            return signature;
         }
 
         return NoPayloadSignature;
     }
     
     /**
-     *  Returns true if given block has any payload signature, false otherwise.
+     *  \brief  Query the payload signature of a given block without retrieving its name.
+     *
+     *  The result is memoized for the parse in progress.
+     *
+     *  \return The %PayloadSignature of the given block.
      */
-    FORCEINLINE bool HasPayloadSignature(const BlockIterator& begin,
-                                         const BlockIterator& end) {
+    FORCEINLINE PayloadSignature QueryPayloadSignature(const BlockIterator& begin,
+                                                       const BlockIterator& end) {
+        
+        if (begin->type != ListBlockBeginType &&
+            begin->type != ListItemBlockBeginType)
+            return NoPayloadSignature;
+        
+        int memo = SignatureMemo::Lookup(*begin, SignatureMemo::PayloadEntry);
+        if (memo != SignatureMemo::Unknown)
+            return static_cast<PayloadSignature>(memo);
+        
         Name name;
         SourceData mediaType;
         PayloadSignature signature = GetPayloadSignature(begin, end, name, mediaType);
-        return signature != NoPayloadSignature;
+        return static_cast<PayloadSignature>(SignatureMemo::Store(*begin, SignatureMemo::PayloadEntry, signature));
+    }
+    
+    /**
+     *  Returns true if given block has any payload signature, false otherwise.
+     */
+    FORCEINLINE bool HasPayloadSignature(const BlockIterator& begin,
+                                         const BlockIterator& end) {
+        return QueryPayloadSignature(begin, end) != NoPayloadSignature;
     }
     
     /**
@@ -130,6 +154,71 @@ namespace snowcrash {
         return !HasNestedListBlock(begin, end);
     }
     
+    /**
+     *  \brief  Collect the names of the models defined in markdown blocks.
+     *
+     *  A model is named by its signature or by the resource it belongs to.
+     *  The names include every model the parser defines, a model may still
+     *  turn out to be invalid once parsed.
+     */
+    FORCEINLINE void CollectResourceModelNames(const BlockIterator& begin,
+                                               const BlockIterator& end,
+                                               ResourceModelNames& names) {
+        
+        Name resourceName;
+        for (BlockIterator it = begin; it != end; ++it) {
+            
+            if (it->type == HeaderBlockType) {
+                
+                SignatureToken nameToken, methodToken, uriToken;
+                if (LexResourceHeader(it->content.data(), it->content.length(), methodToken, uriToken)) {
+                    resourceName.clear();
+                }
+                else if (LexNamedResourceHeader(it->content.data(), it->content.length(), nameToken, uriToken)) {
+                    resourceName = SignatureTokenString(it->content.data(), nameToken);
+                    TrimString(resourceName);
+                }
+            }
+            else if (it->type == ListBlockBeginType || it->type == ListItemBlockBeginType) {
+                
+                PayloadSignature signature = QueryPayloadSignature(it, end);
+                if (signature != ModelPayloadSignature &&
+                    signature != ObjectPayloadSignature)
+                    continue;
+                
+                Name name;
+                SourceData mediaType;
+                GetPayloadSignature(it, end, name, mediaType);
+                if (name.empty())
+                    name = resourceName;
+                
+                if (!name.empty())
+                    names.insert(SymbolKey(name));
+            }
+        }
+    }
+    
+    /**
+     *  \brief  Check whether a model not defined yet is defined later in the blueprint.
+     *
+     *  The names of the models are collected on the first query. Without
+     *  the markdown of the whole blueprint no model is defined later.
+     */
+    FORCEINLINE bool IsResourceModelDefinedAhead(const SymbolKey& symbol,
+                                                 BlueprintParserCore& parser) {
+        
+        if (!parser.markdown)
+            return false;
+        
+        SymbolTable& symbolTable = parser.symbolTable;
+        if (!symbolTable.modelNamesCollected) {
+            CollectResourceModelNames(parser.markdown->begin(), parser.markdown->end(), symbolTable.modelNames);
+            symbolTable.modelNamesCollected = true;
+        }
+        
+        return symbolTable.modelNames.find(symbol) != symbolTable.modelNames.end();
+    }
+    
     /**
      *  Classifier of internal list items, payload context.
      */
@@ -171,9 +260,7 @@ namespace snowcrash {
         
         if (context == UndefinedSectionType) {
             
-            Name name;
-            SourceData mediaType;
-            PayloadSignature payload = GetPayloadSignature(begin, end, name, mediaType);
+            PayloadSignature payload = QueryPayloadSignature(begin, end);
             if (payload == RequestPayloadSignature) {
 
                 return (HasNestedListBlock(begin, end)) ? RequestSectionType : RequestBodySectionType;
@@ -314,7 +401,7 @@ namespace snowcrash {
             // Signature
             if (sectionCur == section.bounds.first) {
 
-                ProcessSignature(section, sectionCur, parser.sourceData, result.first, payload);
+                ProcessSignature(section, sectionCur, parser, result.first, payload);
                 sectionCur = FirstContentBlock(cur, section.bounds.second);
 
                 result.second = ++sectionCur;
@@ -325,7 +412,7 @@ namespace snowcrash {
             // Description
             result = ParseDescriptionBlock<Payload>(section,
                                                     sectionCur,
-                                                    parser.sourceData,
+                                                    parser,
                                                     payload);
             return result;
 
@@ -349,7 +436,7 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
 
-            if (!SetAsset(section.type, asset, payload)) {
+            if (!SetAsset(section.type, std::move(asset), payload)) {
                 // WARN: asset already set
                 std::stringstream ss;
                 ss << "ignoring additional " << SectionName(section.type) << " content, content is already defined";
@@ -386,8 +473,10 @@ namespace snowcrash {
             
             if (result.second != cur) {
                 // Process a symbol reference
-                ResourceModelSymbolTable::const_iterator symbolEntry = parser.symbolTable.resourceModels.find(symbol);
-                if (symbolEntry == parser.symbolTable.resourceModels.end()) {
+                SymbolKey key = SymbolKey::Normalized(symbol);
+                const ResourceModel* model = FindResourceModel(parser.symbolTable, key);
+                if (!model &&
+                    (!IsForwardReferenceAllowed(section.type) || !IsResourceModelDefinedAhead(key, parser))) {
                     
                     // ERR: Undefined symbol
                     std::stringstream ss;
@@ -398,8 +487,23 @@ namespace snowcrash {
                     return result;
                 }
                 
-                // Retrieve payload from symbol table
-                payload = symbolEntry->second;
+                ResourceModelReference reference;
+                reference.symbol = key;
+                reference.sourceMap = symbolSourceMap;
+                parser.symbolTable.references.push_back(reference);
+                
+                if (model) {
+                    // Retrieve payload from symbol table, the body and schema are shared
+                    payload = *model;
+                    parser.budget.spendASTBytes(ResourceModelDescriptionBytes(parser.symbolTable, key));
+                }
+                else {
+                    // Resolved once the blueprint is parsed, see BlueprintParser::Parse()
+                    payload = Payload();
+                    parser.symbolTable.forwardReferences.push_back(reference);
+                }
+                
+                payload.reference = symbol;
             }
             else {
                 // Parse as an asset
@@ -407,11 +511,24 @@ namespace snowcrash {
             }
             
             // Retrieve signature
-            ProcessSignature(section, cur, parser.sourceData, result.first, payload);
+            ProcessSignature(section, cur, parser, result.first, payload);
             
             return result;
         }
         
+        /** 
+         *  \return True if a payload of a section may refer to a model defined later.
+         *
+         *  A model refers only to a model defined before it, so that
+         *  the models never refer to each other in a cycle.
+         */
+        static bool IsForwardReferenceAllowed(SectionType section) {
+            return section == RequestSectionType ||
+                   section == RequestBodySectionType ||
+                   section == ResponseSectionType ||
+                   section == ResponseBodySectionType;
+        }
+        
         /**
          *  \brief  Parse a symbol reference.
          *  \param  begin   The begin of the block to be parsed.
@@ -496,7 +613,7 @@ namespace snowcrash {
          */
         static void ProcessSignature(const BlueprintSection& section,
                                      const BlockIterator& cur,
-                                     const SourceData& sourceData,
+                                     BlueprintParserCore& parser,
                                      Result& result,
                                      Payload& payload) {
             
@@ -508,7 +625,7 @@ namespace snowcrash {
             GetPayloadSignature(cur, section.bounds.second, payload.name, mediaType);
             
             // Check signature
-            if (!CheckSignature(section, cur, signature, sourceData, result)) {
+            if (!CheckSignature(section, cur, signature, parser.sourceData, result)) {
                 // Clear all readouts
                 payload.name.clear();
                 mediaType.clear();
@@ -520,6 +637,7 @@ namespace snowcrash {
                 section.type != RequestBodySectionType &&
                 section.type != ResponseBodySectionType) {
                 payload.description += remainingContent;
+                parser.budget.spendDescriptionBytes(remainingContent.length());
             }
             
             // WARN: missing status code
@@ -527,7 +645,7 @@ namespace snowcrash {
                 (section.type == ResponseSectionType || section.type == ResponseBodySectionType)) {
                 
                 BlockIterator nameBlock = ListItemNameBlock(cur, section.bounds.second);
-                SourceCharactersBlock sourceBlock = CharacterMapForBlock(nameBlock, cur, section.bounds, sourceData);
+                SourceCharactersBlock sourceBlock = CharacterMapForBlock(nameBlock, cur, section.bounds, parser.sourceData);
                 result.warnings.push_back(Warning("missing response HTTP status code, assuming 'Response 200'",
                                                   EmptyDefinitionWarning,
                                                   sourceBlock));
@@ -542,7 +660,7 @@ namespace snowcrash {
                 ss << "the 'object' keyword is deprecated and as such it will be removed in a future release, please use the 'model' keyword instead";
                 
                 BlockIterator nameBlock = ListItemNameBlock(cur, section.bounds.second);
-                SourceCharactersBlock sourceBlock = CharacterMapForBlock(nameBlock, cur, section.bounds, sourceData);
+                SourceCharactersBlock sourceBlock = CharacterMapForBlock(nameBlock, cur, section.bounds, parser.sourceData);
                 result.warnings.push_back(Warning(ss.str(),
                                                   DeprecatedWarning,
                                                   sourceBlock));
@@ -551,7 +669,7 @@ namespace snowcrash {
             if (!mediaType.empty()) {
                 Header header = std::make_pair(HTTPHeaderName::ContentType, mediaType);
                 TrimString(header.second);
-                payload.headers.push_back(header);
+                payload.headers.push_back(std::move(header));
             }
         }
         
@@ -565,7 +683,7 @@ namespace snowcrash {
                                    const SourceData& sourceData,
                                    Result& result) {
             
-            std::string regex;
+            const char* regex;
             switch (section.type) {
                     
                 case RequestSectionType:
@@ -587,17 +705,20 @@ namespace snowcrash {
                     return true;
             }
             
-            CaptureGroups captureGroups;
-            if (RegexCapture(signature, regex, captureGroups) &&
-                !captureGroups.empty()) {
+            CaptureRanges captureRanges;
+            if (RegexCaptureRanges(signature, regex, captureRanges, 1)) {
 
-                std::string target = signature;
-                std::string::size_type pos = target.find(captureGroups[0]);
-                if (pos != std::string::npos)
-                    target.replace(pos, captureGroups[0].length(), std::string());
-
-                TrimString(target);
-                if (!target.empty()) {
+                // Check there is nothing but whitespace outside the match
+                const CaptureRange& match = captureRanges[0];
+                bool unparsed = false;
+                for (size_t i = 0; i < signature.length() && !unparsed; ++i) {
+                    if (i >= match.location && i < match.location + match.length)
+                        continue;
+                    
+                    unparsed = !isSpace(signature[i]);
+                }
+                
+                if (unparsed) {
                     // WARN: unable to parse payload signature
                     std::stringstream ss;
                     ss << "unable to parse " << SectionName(section.type) << " signature, expected ";
@@ -640,7 +761,7 @@ namespace snowcrash {
          *  \brief  Set payload's asset. 
          *  \return True on success, false when an asset is already set.
          */
-        static bool SetAsset(const SectionType& sectionType, const Asset& asset, Payload& payload) {
+        static bool SetAsset(const SectionType& sectionType, Asset&& asset, Payload& payload) {
             
             if (sectionType == BodySectionType ||
                 sectionType == RequestBodySectionType ||
@@ -651,14 +772,14 @@ namespace snowcrash {
                 if (!payload.body.empty())
                     return false;
 
-                payload.body = asset;
+                payload.body = std::move(asset);
             }
             else if (sectionType == SchemaSectionType ||
                      sectionType == DanglingSchemaSectionType) {
                 if (!payload.schema.empty())
                     return false;
                 
-                payload.schema = asset;
+                payload.schema = std::move(asset);
             }
             
             return true;
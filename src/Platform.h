@@ -18,16 +18,19 @@
 
 #if defined(_MSC_VER)
 #   define FORCEINLINE __forceinline
+#   define THREADLOCAL __declspec(thread)
 #   if !defined(DEPRECATED)
 #       define DEPRECATED __declspec(deprecated)
 #   endif
 #elif defined(__clang__) || defined(__GNUC__)
 #   define FORCEINLINE inline
+#   define THREADLOCAL __thread
 #   if !defined(DEPRECATED)
 #       define DEPRECATED __attribute__((deprecated))
 #   endif
 #else
 #   define FORCEINLINE inline
+#   define THREADLOCAL
 #   if !defined(DEPRECATED)
 #       define DEPRECATED
 #   endif
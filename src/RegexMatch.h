@@ -27,6 +27,69 @@ namespace snowcrash {
     // Performs posix-regex
     // returns true if target string matches given expression, false otherwise
     bool RegexCapture(const std::string& target, const std::string& expression, CaptureGroups& captureGroups, size_t groupSize = 8);
+    
+    /**
+     *  \brief  A byte range of a captured group within the target string.
+     *
+     *  Groups that did not participate in the match are empty.
+     */
+    struct CaptureRange {
+        size_t location;
+        size_t length;
+    };
+    
+    /** Maximum number of capture ranges retrieved by %RegexCaptureRanges */
+    const size_t MaxCaptureRangesSize = 10;
+    
+    /**
+     *  \brief  Fixed-size array of capture ranges.
+     *
+     *  The first range is the whole match followed by the capture groups.
+     */
+    struct CaptureRanges {
+        CaptureRange groups[MaxCaptureRangesSize];
+        size_t size;
+        
+        const CaptureRange& operator[](size_t i) const { return groups[i]; }
+    };
+    
+    /**
+     *  \brief  Performs posix-regex retrieving byte ranges of the captured groups.
+     *
+     *  Unlike %RegexCapture no captured text is copied and the match
+     *  data lives on the stack. Use %CaptureRangeString to retrieve the
+     *  text of a group when needed.
+     *
+     *  \param  groupSize   Number of ranges to retrieve, at most %MaxCaptureRangesSize.
+     *  \return True if target string matches given expression, false otherwise.
+     */
+    bool RegexCaptureRanges(const std::string& target, const std::string& expression, CaptureRanges& captureRanges, size_t groupSize = MaxCaptureRangesSize);
+    
+    /** \return Text of a captured range of the target string */
+    std::string CaptureRangeString(const std::string& target, const CaptureRange& range);
+    
+    /**
+     *  \brief  Compiled regex cache statistics.
+     *
+     *  Expressions are compiled once and kept in a process-wide
+     *  cache shared by all the regex functions above.
+     */
+    struct RegexCacheStatistics {
+        size_t hits;        /// < Lookups served by an already compiled expression
+        size_t misses;      /// < Lookups of an expression not in the cache
+        size_t compiles;    /// < Successfully compiled expressions
+        size_t evictions;   /// < Expressions dropped to keep the cache bounded
+        size_t size;        /// < Expressions currently in the cache
+    };
+    
+    /** Maximum number of compiled expressions held in the cache */
+    extern const size_t RegexCacheCapacity;
+    
+    /** \return A snapshot of the compiled regex cache statistics. */
+    RegexCacheStatistics GetRegexCacheStatistics();
+    
+    /** \brief Drop all cached expressions and reset the statistics. */
+    void ResetRegexCache();
 }
 
 #endif
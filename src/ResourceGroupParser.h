@@ -12,6 +12,7 @@
 #include "BlueprintParserCore.h"
 #include "Blueprint.h"
 #include "ResourceParser.h"
+#include "SignatureLexer.h"
 
 namespace snowcrashconst {
     
@@ -31,7 +32,7 @@ namespace snowcrash {
 
         return std::find_if(blueprint.resourceGroups.begin(),
                             blueprint.resourceGroups.end(),
-                            std::bind2nd(MatchName<ResourceGroup>(), group));
+                            std::bind(MatchName<ResourceGroup>(), std::placeholders::_1, std::cref(group)));
     }
     
     /**
@@ -46,9 +47,9 @@ namespace snowcrash {
             block.content.empty())
             return false;
         
-        CaptureGroups captureGroups;
-        if (RegexCapture(block.content, snowcrashconst::GroupHeaderRegex, captureGroups, 3)) {
-            name = captureGroups[1];
+        SignatureToken nameToken;
+        if (LexResourceGroupHeader(block.content.data(), block.content.length(), nameToken)) {
+            name = SignatureTokenString(block.content.data(), nameToken);
             return true;
         }
         
@@ -62,8 +63,17 @@ namespace snowcrash {
      */
     FORCEINLINE bool HasResourceGroupSignature(const MarkdownBlock& block)
     {
+        if (block.type != HeaderBlockType ||
+            block.content.empty())
+            return false;
+        
+        int memo = SignatureMemo::Lookup(block, SignatureMemo::ResourceGroupEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
+        
         Name name;
-        return GetResourceGroupSignature(block, name);
+        bool signature = GetResourceGroupSignature(block, name);
+        return SignatureMemo::Store(block, SignatureMemo::ResourceGroupEntry, signature) != 0;
     }
     
     /** Internal list items classifier, Resource Group Context */
@@ -143,7 +153,7 @@ namespace snowcrash {
             // Group Description
             result = ParseDescriptionBlock<ResourceGroup>(section,
                                                            sectionCur,
-                                                           parser.sourceData,
+                                                           parser,
                                                            group);
             return result;
             
@@ -163,15 +173,7 @@ namespace snowcrash {
             if (result.first.error.code != Error::OK)
                 return result;
             
-            ResourceIterator duplicate = FindResource(group, resource);
-            ResourceIteratorPair globalDuplicate;
-            if (duplicate == group.resources.end())
-                globalDuplicate = FindResource(parser.blueprint, resource);
-
-         
-            
-            if (duplicate != group.resources.end() ||
-                globalDuplicate.first != parser.blueprint.resourceGroups.end()) {
+            if (!parser.resourceIndex.uriTemplates.insert(resource.uriTemplate).second) {
                 
                 // WARN: Duplicate resource
                 SourceCharactersBlock sourceBlock = CharacterMapForBlock(cur, section.bounds.second, section.bounds, parser.sourceData);
@@ -181,10 +183,8 @@ namespace snowcrash {
                                                         DuplicateWarning,
                                                         sourceBlock));
             }
-
-
             
-            group.resources.push_back(resource); // FIXME: C++11 move
+            group.resources.push_back(std::move(resource));
             return result;
         }
     };
@@ -14,6 +14,7 @@
 #include "Blueprint.h"
 #include "ActionParser.h"
 #include "RegexMatch.h"
+#include "SignatureLexer.h"
 #include "StringUtility.h"
 #include "ParametersParser.h"
 #include "DescriptionSectionUtility.h"
@@ -48,18 +49,18 @@ namespace snowcrash {
             block.content.empty())
             return NoResourceSignature;
         
-        CaptureGroups captureGroups;
+        SignatureToken nameToken, methodToken, uriToken;
         // Nameless resource
-        if (RegexCapture(block.content, snowcrashconst::ResourceHeaderRegex, captureGroups, 4)) {
-            method = captureGroups[2];
-            uri = captureGroups[3];
+        if (LexResourceHeader(block.content.data(), block.content.length(), methodToken, uriToken)) {
+            method = SignatureTokenString(block.content.data(), methodToken);
+            uri = SignatureTokenString(block.content.data(), uriToken);
             return (method.empty()) ? URIResourceSignature : MethodURIResourceSignature;
         }
-        else if (RegexCapture(block.content, snowcrashconst::NamedResourceHeaderRegex, captureGroups, 4)) {
+        else if (LexNamedResourceHeader(block.content.data(), block.content.length(), nameToken, uriToken)) {
             method.clear();
-            name = captureGroups[1];
+            name = SignatureTokenString(block.content.data(), nameToken);
             TrimString(name);
-            uri = captureGroups[2];
+            uri = SignatureTokenString(block.content.data(), uriToken);
             return NamedResourceSignature;
         }
 
@@ -69,10 +70,19 @@ namespace snowcrash {
     // Returns true if block has resource header signature, false otherwise
     FORCEINLINE bool HasResourceSignature(const MarkdownBlock& block) {
 
+        if (block.type != HeaderBlockType ||
+            block.content.empty())
+            return false;
+        
+        int memo = SignatureMemo::Lookup(block, SignatureMemo::ResourceEntry);
+        if (memo != SignatureMemo::Unknown)
+            return memo != 0;
+        
         Name name;
         URITemplate uri;
         HTTPMethod method;
-        return GetResourceSignature(block, name, uri, method) != NoResourceSignature;
+        bool signature = GetResourceSignature(block, name, uri, method) != NoResourceSignature;
+        return SignatureMemo::Store(block, SignatureMemo::ResourceEntry, signature) != 0;
     }
 
     // Resource iterator in its containment group
@@ -83,7 +93,7 @@ namespace snowcrash {
                                               const Resource& resource) {
         return std::find_if(group.resources.begin(),
                             group.resources.end(),
-                            std::bind2nd(MatchResource(), resource));
+                            std::bind(MatchResource(), std::placeholders::_1, std::cref(resource)));
     }
 
     // Resource iterator pair: its containment group and resource iterator itself
@@ -118,9 +128,7 @@ namespace snowcrash {
         if (HasParametersSignature(begin, end))
             return ParametersSectionType;
         
-        Name name;
-        SourceData mediaType;
-        PayloadSignature payloadSignature = GetPayloadSignature(begin, end, name, mediaType);
+        PayloadSignature payloadSignature = QueryPayloadSignature(begin, end);
         if (payloadSignature == ObjectPayloadSignature)
             return ObjectSectionType;
         else if (payloadSignature == ModelPayloadSignature)
@@ -293,7 +301,7 @@ namespace snowcrash {
 
             result = ParseDescriptionBlock<Resource>(section,
                                                       sectionCur,
-                                                      parser.sourceData,
+                                                      parser,
                                                       resource);
             return result;
         }
@@ -304,6 +312,7 @@ namespace snowcrash {
                                               Resource& resource)
         {
             Payload payload;
+            size_t descriptionBytes = parser.budget.descriptionBytes();
             ParseSectionResult result = PayloadParser::Parse(cur,
                                                              section.bounds.second,
                                                              section,
@@ -356,10 +365,21 @@ namespace snowcrash {
             }
             
             // Check whether symbol isn't already defined
-            ResourceModelSymbolTable::const_iterator it = parser.symbolTable.resourceModels.find(payload.name);
+            SymbolKey symbol(payload.name);
+            ResourceModelSymbolTable::const_iterator it = parser.symbolTable.resourceModels.find(symbol);
             if (it == parser.symbolTable.resourceModels.end()) {
 
-                parser.symbolTable.resourceModels[payload.name] = payload;
+                parser.symbolTable.resourceModels[symbol] = payload;
+                parser.symbolTable.modelDescriptionBytes[symbol] = parser.budget.descriptionBytes() - descriptionBytes;
+                
+                // Remember where the model is defined, see BuildSymbolIndex()
+                BlockIterator nameBlock = ListItemNameBlock(cur, section.bounds.second);
+                ResourceModelReference definition;
+                definition.symbol = symbol;
+                if (nameBlock != section.bounds.second)
+                    definition.sourceMap = nameBlock->sourceMap;
+                
+                parser.symbolTable.definitions.push_back(definition);
             }
             else {
                 // ERR: Symbol already defined
@@ -374,7 +394,7 @@ namespace snowcrash {
             }
             
             // Assign model
-            resource.model = payload;
+            resource.model = std::move(payload);
             
             return result;
         }
@@ -406,7 +426,9 @@ namespace snowcrash {
                 CheckParametersEligibility(resource, parameters, nameBlock->sourceMap, parser.sourceData, result.first);
                 
                 // Insert
-                resource.parameters.insert(resource.parameters.end(), parameters.begin(), parameters.end());
+                resource.parameters.insert(resource.parameters.end(),
+                                           std::make_move_iterator(parameters.begin()),
+                                           std::make_move_iterator(parameters.end()));
             }
             
             return result;
@@ -519,7 +541,7 @@ namespace snowcrash {
                                                         sourceBlock));
             }
             
-            resource.actions.push_back(action);
+            resource.actions.push_back(std::move(action));
             return result;
         }
         
@@ -0,0 +1,512 @@
+//
+//  SignatureLexer.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include <cstring>
+#include "SignatureLexer.h"
+
+using namespace snowcrash;
+
+/** HTTP methods as in `HTTP_REQUEST_METHOD` */
+static const char* const HTTPRequestMethods[] = {
+    "GET", "POST", "PUT", "DELETE", "OPTIONS", "PATCH", "PROPPATCH", "LOCK",
+    "UNLOCK", "COPY", "MOVE", "MKCOL", "HEAD", "LINK", "UNLINK", "CONNECT"
+};
+
+static const size_t HTTPRequestMethodsCount = sizeof(HTTPRequestMethods) / sizeof(HTTPRequestMethods[0]);
+
+/** `[[:blank:]]` */
+static inline bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+/** `[[:digit:]]` */
+static inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/** `[^][()]`, see `SYMBOL_IDENTIFIER` */
+static inline bool IsSymbolCharacter(char c)
+{
+    return c != '[' && c != ']' && c != '(' && c != ')';
+}
+
+static inline void SetToken(SignatureToken& token, size_t begin, size_t end)
+{
+    token.location = begin;
+    token.length = end - begin;
+}
+
+static inline void ClearToken(SignatureToken& token)
+{
+    token.location = 0;
+    token.length = 0;
+}
+
+/** \return Position of the first non-blank character at or after pos */
+static inline size_t SkipBlanks(const char* s, size_t pos, size_t len)
+{
+    while (pos < len && IsBlank(s[pos]))
+        ++pos;
+    return pos;
+}
+
+/** \return Position of the first character at or after pos that is not a symbol character */
+static inline size_t SkipSymbol(const char* s, size_t pos, size_t len)
+{
+    while (pos < len && IsSymbolCharacter(s[pos]))
+        ++pos;
+    return pos;
+}
+
+/**
+ *  \brief  Match a lowercase keyword at given position, first letter case insensitive.
+ *  \return Length of the keyword if matched, 0 otherwise.
+ */
+static inline size_t MatchKeyword(const char* s, size_t pos, size_t len, const char* keyword)
+{
+    size_t i = 0;
+    for (; keyword[i] != '\0'; ++i) {
+        if (pos + i >= len)
+            return 0;
+
+        char c = s[pos + i];
+        if (i == 0 && c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+
+        if (c != keyword[i])
+            return 0;
+    }
+
+    return i;
+}
+
+/** \return Length of HTTP request method at given position, 0 if there is none. */
+static inline size_t MatchHTTPMethod(const char* s, size_t pos, size_t len)
+{
+    if (pos >= len || s[pos] < 'A' || s[pos] > 'Z')
+        return 0;
+
+    // No method is a prefix of another, at most one can match
+    for (size_t i = 0; i < HTTPRequestMethodsCount; ++i) {
+        const char* method = HTTPRequestMethods[i];
+        if (method[0] != s[pos])
+            continue;
+
+        size_t n = ::strlen(method);
+        if (pos + n <= len && ::strncmp(s + pos, method, n) == 0)
+            return n;
+    }
+
+    return 0;
+}
+
+/**
+ *  \brief  Match `MEDIA_TYPE` - `[[:blank:]]*\(([^\)]*)\)` at given position.
+ *  \param  end         Position just after the closing parenthesis.
+ *  \param  mediaType   Media type token (parenthesis contents).
+ *  \return True if matched, false otherwise.
+ */
+static inline bool MatchMediaType(const char* s, size_t pos, size_t len, size_t& end, SignatureToken& mediaType)
+{
+    pos = SkipBlanks(s, pos, len);
+    if (pos >= len || s[pos] != '(')
+        return false;
+
+    // Note the backslash is literal in a bracket expression
+    size_t i = pos + 1;
+    while (i < len && s[i] != ')' && s[i] != '\\')
+        ++i;
+
+    if (i >= len || s[i] != ')')
+        return false;
+
+    SetToken(mediaType, pos + 1, i);
+    end = i + 1;
+    return true;
+}
+
+/** \return Position of the first character that is not a symbol character */
+static inline size_t FindNonSymbolCharacter(const char* s, size_t len)
+{
+    return SkipSymbol(s, 0, len);
+}
+
+std::string snowcrash::SignatureTokenString(const std::string& source, const SignatureToken& token)
+{
+    if (!token.length)
+        return std::string();
+
+    return source.substr(token.location, token.length);
+}
+
+std::string snowcrash::SignatureTokenString(const char* source, const SignatureToken& token)
+{
+    if (!token.length)
+        return std::string();
+
+    return std::string(source + token.location, token.length);
+}
+
+bool snowcrash::LexResourceGroupHeader(const std::string& source, SignatureToken& name)
+{
+    const char* s = source.c_str();
+    return LexResourceGroupHeader(s, ::strlen(s), name);
+}
+
+bool snowcrash::LexResourceGroupHeader(const char* s, size_t len, SignatureToken& name)
+{
+    // ^[[:blank:]]*[Gg]roup[[:blank:]]+([^][()]+)[[:blank:]]*$
+    size_t pos = SkipBlanks(s, 0, len);
+    size_t n = MatchKeyword(s, pos, len, "group");
+    if (!n)
+        return false;
+
+    pos += n;
+    size_t nameBegin = SkipBlanks(s, pos, len);
+    if (nameBegin == pos || len - pos < 2)
+        return false;
+
+    if (SkipSymbol(s, nameBegin, len) != len)
+        return false;
+
+    // Blanks-only remainder, name is the last blank character
+    if (nameBegin == len)
+        nameBegin = len - 1;
+
+    SetToken(name, nameBegin, len);
+    return true;
+}
+
+bool snowcrash::LexResourceHeader(const std::string& source, SignatureToken& method, SignatureToken& uri)
+{
+    const char* s = source.c_str();
+    return LexResourceHeader(s, ::strlen(s), method, uri);
+}
+
+bool snowcrash::LexResourceHeader(const char* s, size_t len, SignatureToken& method, SignatureToken& uri)
+{
+    // ^[[:blank:]]*(METHOD[[:blank:]]+)?(/.*)$
+    size_t pos = SkipBlanks(s, 0, len);
+    size_t n = MatchHTTPMethod(s, pos, len);
+    if (n) {
+        size_t uriBegin = SkipBlanks(s, pos + n, len);
+        if (uriBegin == pos + n || uriBegin >= len || s[uriBegin] != '/')
+            return false;
+
+        SetToken(method, pos, pos + n);
+        SetToken(uri, uriBegin, len);
+        return true;
+    }
+
+    if (pos >= len || s[pos] != '/')
+        return false;
+
+    ClearToken(method);
+    SetToken(uri, pos, len);
+    return true;
+}
+
+bool snowcrash::LexNamedResourceHeader(const std::string& source, SignatureToken& name, SignatureToken& uri)
+{
+    const char* s = source.c_str();
+    return LexNamedResourceHeader(s, ::strlen(s), name, uri);
+}
+
+bool snowcrash::LexNamedResourceHeader(const char* s, size_t len, SignatureToken& name, SignatureToken& uri)
+{
+    // ^[[:blank:]]*([^][()]+)[[:blank:]]+\[(/.*)]$
+    size_t bracket = FindNonSymbolCharacter(s, len);
+    if (bracket >= len || s[bracket] != '[')
+        return false;
+
+    // At least one name character followed by a blank
+    if (bracket < 2 || !IsBlank(s[bracket - 1]))
+        return false;
+
+    if (bracket + 2 >= len || s[bracket + 1] != '/' || s[len - 1] != ']')
+        return false;
+
+    size_t nameBegin = SkipBlanks(s, 0, len);
+    if (nameBegin > bracket - 2)
+        nameBegin = bracket - 2;
+
+    SetToken(name, nameBegin, bracket - 1);
+    SetToken(uri, bracket + 1, len - 1);
+    return true;
+}
+
+bool snowcrash::LexActionHeader(const std::string& source, SignatureToken& method, SignatureToken& uri)
+{
+    const char* s = source.c_str();
+    return LexActionHeader(s, ::strlen(s), method, uri);
+}
+
+bool snowcrash::LexActionHeader(const char* s, size_t len, SignatureToken& method, SignatureToken& uri)
+{
+    // ^[[:blank:]]*METHOD[[:blank:]]*(/.*)?$
+    size_t pos = SkipBlanks(s, 0, len);
+    size_t n = MatchHTTPMethod(s, pos, len);
+    if (!n)
+        return false;
+
+    size_t uriBegin = SkipBlanks(s, pos + n, len);
+    if (uriBegin == len) {
+        SetToken(method, pos, pos + n);
+        ClearToken(uri);
+        return true;
+    }
+
+    if (s[uriBegin] != '/')
+        return false;
+
+    SetToken(method, pos, pos + n);
+    SetToken(uri, uriBegin, len);
+    return true;
+}
+
+bool snowcrash::LexNamedActionHeader(const std::string& source, SignatureToken& name, SignatureToken& method)
+{
+    const char* s = source.c_str();
+    return LexNamedActionHeader(s, ::strlen(s), name, method);
+}
+
+bool snowcrash::LexNamedActionHeader(const char* s, size_t len, SignatureToken& name, SignatureToken& method)
+{
+    // ^[[:blank:]]*([^][()]+)\[METHOD]$
+    size_t bracket = FindNonSymbolCharacter(s, len);
+    if (bracket == 0 || bracket >= len || s[bracket] != '[')
+        return false;
+
+    size_t n = MatchHTTPMethod(s, bracket + 1, len);
+    if (!n || bracket + n + 2 != len || s[len - 1] != ']')
+        return false;
+
+    size_t nameBegin = SkipBlanks(s, 0, len);
+    if (nameBegin > bracket - 1)
+        nameBegin = bracket - 1;
+
+    SetToken(name, nameBegin, bracket);
+    SetToken(method, bracket + 1, bracket + 1 + n);
+    return true;
+}
+
+/**
+ *  \brief  Lex request signature following the leading blanks.
+ *  \param  pos Position of the first non-blank character.
+ */
+static bool LexRequest(const char* s, size_t pos, size_t len, SignatureToken& name, SignatureToken& mediaType)
+{
+    size_t n = MatchKeyword(s, pos, len, "request");
+    if (!n)
+        return false;
+
+    pos += n;
+    size_t nameEnd = SkipSymbol(s, pos, len);
+    SetToken(name, pos, nameEnd);
+
+    size_t end;
+    if (!MatchMediaType(s, nameEnd, len, end, mediaType))
+        ClearToken(mediaType);
+
+    return true;
+}
+
+/**
+ *  \brief  Lex response signature following the leading blanks.
+ *  \param  pos Position of the first non-blank character.
+ */
+static bool LexResponse(const char* s, size_t pos, size_t len, SignatureToken& name, SignatureToken& mediaType)
+{
+    size_t n = MatchKeyword(s, pos, len, "response");
+    if (!n)
+        return false;
+
+    pos += n;
+    size_t nameEnd = pos;
+    while (nameEnd < len && (IsBlank(s[nameEnd]) || IsDigit(s[nameEnd])))
+        ++nameEnd;
+
+    SetToken(name, pos, nameEnd);
+
+    size_t end;
+    if (!MatchMediaType(s, nameEnd, len, end, mediaType))
+        ClearToken(mediaType);
+
+    return true;
+}
+
+/**
+ *  \brief  Lex object signature.
+ *  \param  symbolEnd   Position of the first non-symbol character.
+ */
+static bool LexObject(const char* s, size_t symbolEnd, size_t len, SignatureToken& name, SignatureToken& mediaType)
+{
+    // The keyword has to be followed by blanks only up to
+    // the first non-symbol character or the end of line
+    size_t keywordEnd = symbolEnd;
+    while (keywordEnd > 0 && IsBlank(s[keywordEnd - 1]))
+        --keywordEnd;
+
+    static const size_t KeywordLength = 6;
+    if (keywordEnd < KeywordLength + 1)
+        return false;
+
+    size_t keyword = keywordEnd - KeywordLength;
+    if (!MatchKeyword(s, keyword, len, "object"))
+        return false;
+
+    ClearToken(mediaType);
+    if (symbolEnd < len) {
+        size_t end;
+        if (!MatchMediaType(s, symbolEnd, len, end, mediaType) ||
+            SkipBlanks(s, end, len) != len)
+            return false;
+    }
+
+    size_t nameBegin = SkipBlanks(s, 0, len);
+    if (nameBegin > keyword - 1)
+        nameBegin = keyword - 1;
+
+    SetToken(name, nameBegin, keyword);
+    return true;
+}
+
+/** Length of the model keyword */
+static const size_t ModelKeywordLength = 5;
+
+/**
+ *  \brief  Lex model signature.
+ *
+ *  The longest match is given by the last keyword
+ *  preceding the first non-symbol character.
+ *
+ *  \param  keyword Position of the last model keyword.
+ */
+static void LexModel(const char* s, size_t keyword, size_t len, SignatureToken& name, SignatureToken& mediaType)
+{
+    size_t nameBegin = SkipBlanks(s, 0, len);
+    if (nameBegin < keyword)
+        SetToken(name, nameBegin, keyword);
+    else
+        ClearToken(name);
+
+    size_t end;
+    if (!MatchMediaType(s, keyword + ModelKeywordLength, len, end, mediaType))
+        ClearToken(mediaType);
+}
+
+bool snowcrash::LexRequestSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType)
+{
+    // ^[[:blank:]]*[Rr]equest([^][()]+)?MEDIA_TYPE?[[:blank:]]*
+    const char* s = source.c_str();
+    size_t len = ::strlen(s);
+    return LexRequest(s, SkipBlanks(s, 0, len), len, name, mediaType);
+}
+
+bool snowcrash::LexResponseSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType)
+{
+    // ^[[:blank:]]*[Rr]esponse([[:blank:][:digit:]]+)?MEDIA_TYPE?[[:blank:]]*
+    const char* s = source.c_str();
+    size_t len = ::strlen(s);
+    return LexResponse(s, SkipBlanks(s, 0, len), len, name, mediaType);
+}
+
+bool snowcrash::LexObjectSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType)
+{
+    // ^[[:blank:]]*([^][()]+)[Oo]bject MEDIA_TYPE?[[:blank:]]*$
+    const char* s = source.c_str();
+    size_t len = ::strlen(s);
+    return LexObject(s, FindNonSymbolCharacter(s, len), len, name, mediaType);
+}
+
+bool snowcrash::LexModelSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType)
+{
+    // ^[[:blank:]]*([^][()]+)?[Mm]odel MEDIA_TYPE?[[:blank:]]*
+    const char* s = source.c_str();
+    size_t len = ::strlen(s);
+
+    size_t symbolEnd = FindNonSymbolCharacter(s, len);
+    if (symbolEnd < ModelKeywordLength)
+        return false;
+
+    size_t keyword = symbolEnd - ModelKeywordLength + 1;
+    do {
+        --keyword;
+        if (MatchKeyword(s, keyword, len, "model"))
+            break;
+
+        if (keyword == 0)
+            return false;
+
+    } while (true);
+
+    LexModel(s, keyword, len, name, mediaType);
+    return true;
+}
+
+PayloadKeyword snowcrash::LexPayloadSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType)
+{
+    const char* s = source.c_str();
+    return LexPayloadSignature(s, ::strlen(s), name, mediaType);
+}
+
+PayloadKeyword snowcrash::LexPayloadSignature(const char* s, size_t len, SignatureToken& name, SignatureToken& mediaType)
+{
+    // Request and response keywords lead the signature
+    size_t pos = SkipBlanks(s, 0, len);
+    if (pos < len && (s[pos] == 'R' || s[pos] == 'r')) {
+
+        if (LexRequest(s, pos, len, name, mediaType))
+            return RequestPayloadKeyword;
+
+        if (LexResponse(s, pos, len, name, mediaType))
+            return ResponsePayloadKeyword;
+    }
+
+    // Object and model keywords are within the leading symbol
+    // characters, find its end and the last model keyword at once
+    size_t symbolEnd = pos;
+    size_t model = std::string::npos;
+    for (; symbolEnd < len && IsSymbolCharacter(s[symbolEnd]); ++symbolEnd) {
+        if ((s[symbolEnd] == 'M' || s[symbolEnd] == 'm') &&
+            MatchKeyword(s, symbolEnd, len, "model"))
+            model = symbolEnd;
+    }
+
+    if (LexObject(s, symbolEnd, len, name, mediaType))
+        return ObjectPayloadKeyword;
+
+    if (model != std::string::npos) {
+        LexModel(s, model, len, name, mediaType);
+        return ModelPayloadKeyword;
+    }
+
+    return NoPayloadKeyword;
+}
+
+bool snowcrash::LexKeywordSignature(const std::string& source, const char* keyword, bool plural)
+{
+    const char* s = source.c_str();
+    return LexKeywordSignature(s, ::strlen(s), keyword, plural);
+}
+
+bool snowcrash::LexKeywordSignature(const char* s, size_t len, const char* keyword, bool plural)
+{
+    // ^[[:blank:]]*[Kk]eywords?[[:blank:]]*$
+    size_t pos = SkipBlanks(s, 0, len);
+    size_t n = MatchKeyword(s, pos, len, keyword);
+    if (!n)
+        return false;
+
+    pos += n;
+    if (plural && pos < len && s[pos] == 's')
+        ++pos;
+
+    return SkipBlanks(s, pos, len) == len;
+}
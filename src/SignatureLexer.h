@@ -0,0 +1,206 @@
+//
+//  SignatureLexer.h
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#ifndef SNOWCRASH_SIGNATURELEXER_H
+#define SNOWCRASH_SIGNATURELEXER_H
+
+#include <string>
+
+namespace snowcrash {
+
+    /**
+     *  \brief  A token recognized by the signature lexer.
+     *
+     *  Byte range of the token within the lexed line. Tokens of an
+     *  optional part of the signature that is not present are empty.
+     */
+    struct SignatureToken {
+        size_t location;
+        size_t length;
+    };
+
+    /**
+     *  \brief  Build a string out of a signature token.
+     *  \param  source  The line the token was lexed from.
+     *  \param  token   A token to retrieve.
+     *  \return The token text, empty string for an empty token.
+     */
+    std::string SignatureTokenString(const std::string& source, const SignatureToken& token);
+
+    /** \copydoc SignatureTokenString(const std::string&, const SignatureToken&) */
+    std::string SignatureTokenString(const char* source, const SignatureToken& token);
+
+    /**
+     *  Signature lexer
+     *
+     *  Hand-written, single-pass recognizers of section header signatures.
+     *  Each of the lexers below accepts exactly the same language as its
+     *  regular expression counterpart (named in the comment) and yields
+     *  the same captures, but it does not allocate any memory.
+     *
+     *  As with the regular expressions the input is considered up to its
+     *  first NUL character.
+     */
+
+    /**
+     *  \brief  Lex a resource group header, `GroupHeaderRegex`.
+     *  \param  name    Output token of the group name.
+     *  \return True if source is a resource group header, false otherwise.
+     */
+    bool LexResourceGroupHeader(const std::string& source, SignatureToken& name);
+
+    /**
+     *  \brief  Lex a resource group header of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexResourceGroupHeader(const char* source, size_t length, SignatureToken& name);
+
+    /**
+     *  \brief  Lex a nameless resource header, `ResourceHeaderRegex`.
+     *  \param  method  Output token of the HTTP method, empty if not present.
+     *  \param  uri     Output token of the URI template.
+     *  \return True if source is a nameless resource header, false otherwise.
+     */
+    bool LexResourceHeader(const std::string& source, SignatureToken& method, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a nameless resource header of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexResourceHeader(const char* source, size_t length, SignatureToken& method, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a named resource header, `NamedResourceHeaderRegex`.
+     *  \param  name    Output token of the resource name (untrimmed).
+     *  \param  uri     Output token of the URI template.
+     *  \return True if source is a named resource header, false otherwise.
+     */
+    bool LexNamedResourceHeader(const std::string& source, SignatureToken& name, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a named resource header of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexNamedResourceHeader(const char* source, size_t length, SignatureToken& name, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a nameless action header, `ActionHeaderRegex`.
+     *  \param  method  Output token of the HTTP method.
+     *  \param  uri     Output token of the URI template, empty if not present.
+     *  \return True if source is a nameless action header, false otherwise.
+     */
+    bool LexActionHeader(const std::string& source, SignatureToken& method, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a nameless action header of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexActionHeader(const char* source, size_t length, SignatureToken& method, SignatureToken& uri);
+
+    /**
+     *  \brief  Lex a named action header, `NamedActionHeaderRegex`.
+     *  \param  name    Output token of the action name (untrimmed).
+     *  \param  method  Output token of the HTTP method.
+     *  \return True if source is a named action header, false otherwise.
+     */
+    bool LexNamedActionHeader(const std::string& source, SignatureToken& name, SignatureToken& method);
+
+    /**
+     *  \brief  Lex a named action header of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexNamedActionHeader(const char* source, size_t length, SignatureToken& name, SignatureToken& method);
+
+    /**
+     *  \brief  Lex a request signature, `RequestRegex`.
+     *  \param  name        Output token of the request name (untrimmed).
+     *  \param  mediaType   Output token of the media type.
+     *  \return True if source has a request signature, false otherwise.
+     */
+    bool LexRequestSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Lex a response signature, `ResponseRegex`.
+     *  \param  name        Output token of the status code (untrimmed).
+     *  \param  mediaType   Output token of the media type.
+     *  \return True if source has a response signature, false otherwise.
+     */
+    bool LexResponseSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Lex an object signature, `ObjectRegex`.
+     *  \param  name        Output token of the object name (untrimmed).
+     *  \param  mediaType   Output token of the media type.
+     *  \return True if source has an object signature, false otherwise.
+     */
+    bool LexObjectSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Lex a model signature, `ModelRegex`.
+     *  \param  name        Output token of the model name (untrimmed).
+     *  \param  mediaType   Output token of the media type.
+     *  \return True if source has a model signature, false otherwise.
+     */
+    bool LexModelSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Payload signature keyword as recognized by %LexPayloadSignature.
+     */
+    enum PayloadKeyword {
+        NoPayloadKeyword = 0,
+        RequestPayloadKeyword,
+        ResponsePayloadKeyword,
+        ObjectPayloadKeyword,
+        ModelPayloadKeyword
+    };
+
+    /**
+     *  \brief  Lex any of the payload signatures at once.
+     *
+     *  Dispatches on the leading keyword and scans the source once, the
+     *  result is the same as trying %LexRequestSignature, %LexResponseSignature,
+     *  %LexObjectSignature and %LexModelSignature in this order.
+     *
+     *  \param  name        Output token of the payload name (untrimmed).
+     *  \param  mediaType   Output token of the media type.
+     *  \return The first payload signature the source has, %NoPayloadKeyword if none.
+     */
+    PayloadKeyword LexPayloadSignature(const std::string& source, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Lex any of the payload signatures of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    PayloadKeyword LexPayloadSignature(const char* source, size_t length, SignatureToken& name, SignatureToken& mediaType);
+
+    /**
+     *  \brief  Lex a keyword signature such as `BodyRegex` or `HeadersRegex`.
+     *
+     *  Matches `^[[:blank:]]*[Kk]eyword[[:blank:]]*$` where only the first
+     *  letter of the keyword is case insensitive.
+     *
+     *  \param  keyword A lowercase keyword to look for.
+     *  \param  plural  True to accept an optional trailing 's' of the keyword.
+     *  \return True if source is the keyword signature, false otherwise.
+     */
+    bool LexKeywordSignature(const std::string& source, const char* keyword, bool plural = false);
+
+    /**
+     *  \brief  Lex a keyword signature of a line slice.
+     *  \param  source  The line, not necessarily NUL-terminated.
+     *  \param  length  Length of the line in bytes.
+     */
+    bool LexKeywordSignature(const char* source, size_t length, const char* keyword, bool plural = false);
+}
+
+#endif
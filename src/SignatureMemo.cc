@@ -0,0 +1,97 @@
+//
+//  SignatureMemo.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include <functional>
+#include "SignatureMemo.h"
+#include "Platform.h"
+
+using namespace snowcrash;
+
+/** Slot value of a signature not classified yet */
+static const unsigned char UnknownSlot = 0xFF;
+
+/** Memo active in the current thread */
+static THREADLOCAL SignatureMemo* ActiveSignatureMemo = NULL;
+
+/** Statistics of the current thread */
+static THREADLOCAL SignatureMemoStatistics ThreadSignatureMemoStatistics = { 0, 0, 0 };
+
+SignatureMemo::SignatureMemo()
+: m_blocks(NULL), m_size(0)
+{
+}
+
+SignatureMemo::Scope::Scope(SignatureMemo& memo, const MarkdownBlock::Stack& blocks)
+: m_previous(ActiveSignatureMemo)
+{
+    memo.m_blocks = (blocks.empty()) ? NULL : &blocks.front();
+    memo.m_size = blocks.size();
+    memo.m_entries.assign(blocks.size() * EntryCount, UnknownSlot);
+
+    ActiveSignatureMemo = &memo;
+}
+
+SignatureMemo::Scope::~Scope()
+{
+    ActiveSignatureMemo = m_previous;
+}
+
+bool SignatureMemo::Slot(const MarkdownBlock& block, Entry entry, size_t& index) const
+{
+    if (!m_blocks)
+        return false;
+
+    // Blocks of other stacks are not ordered with the bound one
+    std::less<const MarkdownBlock*> less;
+    if (less(&block, m_blocks) || !less(&block, m_blocks + m_size))
+        return false;
+
+    index = static_cast<size_t>(&block - m_blocks) * EntryCount + entry;
+    return true;
+}
+
+int SignatureMemo::Lookup(const MarkdownBlock& block, Entry entry)
+{
+    size_t index;
+    if (!ActiveSignatureMemo || !ActiveSignatureMemo->Slot(block, entry, index))
+        return Unknown;
+
+    ++ThreadSignatureMemoStatistics.lookups;
+
+    unsigned char slot = ActiveSignatureMemo->m_entries[index];
+    if (slot == UnknownSlot)
+        return Unknown;
+
+    ++ThreadSignatureMemoStatistics.hits;
+    return slot;
+}
+
+int SignatureMemo::Store(const MarkdownBlock& block, Entry entry, int value)
+{
+    size_t index;
+    if (!ActiveSignatureMemo || !ActiveSignatureMemo->Slot(block, entry, index))
+        return value;
+
+    if (value < 0 || value >= UnknownSlot)
+        return value;
+
+    ActiveSignatureMemo->m_entries[index] = static_cast<unsigned char>(value);
+    ++ThreadSignatureMemoStatistics.stores;
+    return value;
+}
+
+SignatureMemoStatistics snowcrash::GetSignatureMemoStatistics()
+{
+    return ThreadSignatureMemoStatistics;
+}
+
+void snowcrash::ResetSignatureMemoStatistics()
+{
+    ThreadSignatureMemoStatistics.lookups = 0;
+    ThreadSignatureMemoStatistics.hits = 0;
+    ThreadSignatureMemoStatistics.stores = 0;
+}
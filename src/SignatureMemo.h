@@ -0,0 +1,120 @@
+//
+//  SignatureMemo.h
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#ifndef SNOWCRASH_SIGNATUREMEMO_H
+#define SNOWCRASH_SIGNATUREMEMO_H
+
+#include <vector>
+#include "MarkdownBlock.h"
+
+namespace snowcrash {
+
+    /**
+     *  \brief  Signature classification memo statistics.
+     *
+     *  Counted per thread, for the signature memo of the thread only.
+     */
+    struct SignatureMemoStatistics {
+        size_t lookups;     /// < Signature queries served by the memo
+        size_t hits;        /// < Queries answered from the memo (saved classifications)
+        size_t stores;      /// < Signatures classified and recorded
+    };
+
+    /**
+     *  \brief  Per-parse memo of markdown block signatures.
+     *
+     *  Section classifiers query the very same block for the same
+     *  signature over and over as the parser descends. Every block
+     *  has a slot per signature query, once a signature is classified
+     *  its result is recorded and served for the rest of the parse.
+     *
+     *  Results do not depend on the end of the queried range - the
+     *  lookahead of a signature query never leaves the list item being
+     *  queried and section bounds never split a list item.
+     *
+     *  A memo is bound to a markdown block stack and activated for the
+     *  current thread using a %SignatureMemo::Scope. With no memo active
+     *  (or for a block not in the bound stack) the signature queries
+     *  are evaluated every time.
+     */
+    class SignatureMemo {
+    public:
+
+        /** Memoized signature queries */
+        enum Entry {
+            ResourceGroupEntry = 0,     /// < HasResourceGroupSignature()
+            ResourceEntry,              /// < HasResourceSignature()
+            ActionEntry,                /// < HasActionSignature()
+            PayloadEntry,               /// < QueryPayloadSignature()
+            AssetEntry,                 /// < GetAssetSignature()
+            NestedListEntry,            /// < HasNestedListBlock()
+            HeaderEntry,                /// < HasHeaderSignature()
+            ParametersEntry,            /// < HasParametersSignature()
+            ParameterDefinitionEntry,   /// < HasParameterDefinitionSignature()
+            EntryCount
+        };
+
+        /** Value of a signature not classified yet */
+        static const int Unknown = -1;
+
+        SignatureMemo();
+
+        /**
+         *  \brief  Activates a memo for the lifetime of the scope.
+         *
+         *  Binds the memo to a markdown block stack, dropping any
+         *  previously recorded signatures. The previously active memo
+         *  is restored when the scope ends.
+         */
+        class Scope {
+        public:
+            Scope(SignatureMemo& memo, const MarkdownBlock::Stack& blocks);
+            ~Scope();
+
+        private:
+            SignatureMemo* m_previous;
+
+            Scope();
+            Scope(const Scope&);
+            Scope& operator=(const Scope&);
+        };
+
+        /**
+         *  \brief  Look up a recorded signature of a block in the active memo.
+         *  \return The recorded value, %Unknown if not classified yet.
+         */
+        static int Lookup(const MarkdownBlock& block, Entry entry);
+
+        /**
+         *  \brief  Record a classified signature of a block in the active memo.
+         *  \param  value   A signature value, in the range <0, 255).
+         *  \return The value being recorded.
+         */
+        static int Store(const MarkdownBlock& block, Entry entry, int value);
+
+    private:
+        const MarkdownBlock* m_blocks;
+        size_t m_size;
+        std::vector<unsigned char> m_entries;
+
+        /** \return True and index of the entry slot if block is in the bound stack, false otherwise */
+        bool Slot(const MarkdownBlock& block, Entry entry, size_t& index) const;
+
+        SignatureMemo(const SignatureMemo&);
+        SignatureMemo& operator=(const SignatureMemo&);
+
+        friend class Scope;
+    };
+
+    /** \return The signature memo statistics of the current thread. */
+    SignatureMemoStatistics GetSignatureMemoStatistics();
+
+    /** \brief Reset the signature memo statistics of the current thread. */
+    void ResetSignatureMemoStatistics();
+}
+
+#endif
@@ -0,0 +1,240 @@
+//
+//  SmallVector.h
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#ifndef SNOWCRASH_SMALLVECTOR_H
+#define SNOWCRASH_SMALLVECTOR_H
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+
+namespace snowcrash {
+
+    /**
+     *  \brief  Vector with inline storage for a few elements.
+     *
+     *  Up to %N elements are held in the object itself, the vector
+     *  allocates only when it grows past %N elements. Iterators are
+     *  plain pointers, invalidated as with %std::vector.
+     *
+     *  Elements are copied by assignment, %T must be default
+     *  constructible and assignable. Meant for small plain-old-data
+     *  elements such as source ranges.
+     */
+    template <typename T, size_t N>
+    class SmallVector {
+    public:
+
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        /** Number of elements held without allocation */
+        static const size_t InlineCapacity = N;
+
+        SmallVector()
+        : m_data(m_inline), m_size(0), m_capacity(N) {}
+
+        explicit SmallVector(size_t count, const T& value = T())
+        : m_data(m_inline), m_size(0), m_capacity(N) {
+            assign(count, value);
+        }
+
+        SmallVector(const SmallVector& rhs)
+        : m_data(m_inline), m_size(0), m_capacity(N) {
+            copy(rhs);
+        }
+
+        ~SmallVector() {
+            release();
+        }
+
+        SmallVector& operator=(const SmallVector& rhs) {
+            if (this != &rhs)
+                copy(rhs);
+
+            return *this;
+        }
+
+        iterator begin() { return m_data; }
+        const_iterator begin() const { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator end() const { return m_data + m_size; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        size_t capacity() const { return m_capacity; }
+
+        /** \return True if the elements are held inline */
+        bool isInline() const { return m_data == m_inline; }
+
+        reference operator[](size_t index) { return m_data[index]; }
+        const_reference operator[](size_t index) const { return m_data[index]; }
+
+        reference front() { return m_data[0]; }
+        const_reference front() const { return m_data[0]; }
+        reference back() { return m_data[m_size - 1]; }
+        const_reference back() const { return m_data[m_size - 1]; }
+
+        /** Remove all elements, keep the storage */
+        void clear() { m_size = 0; }
+
+        void reserve(size_t capacity) {
+            if (capacity > m_capacity)
+                reallocate(capacity);
+        }
+
+        void push_back(const T& value) {
+            if (m_size == m_capacity) {
+                T copy(value);  // value may be an element
+                reallocate(m_capacity * 2);
+                m_data[m_size++] = copy;
+            }
+            else {
+                m_data[m_size++] = value;
+            }
+        }
+
+        void pop_back() { --m_size; }
+
+        void assign(size_t count, const T& value) {
+            T copy(value);
+            m_size = 0;
+            reserve(count);
+            std::fill(m_data, m_data + count, copy);
+            m_size = count;
+        }
+
+        void resize(size_t count, const T& value = T()) {
+            if (count > m_size) {
+                T copy(value);
+                reserve(count);
+                std::fill(m_data + m_size, m_data + count, copy);
+            }
+
+            m_size = count;
+        }
+
+        iterator insert(iterator position, const T& value) {
+            size_t index = position - m_data;
+            T copy(value);
+
+            if (m_size == m_capacity)
+                reallocate(m_capacity * 2);
+
+            std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + 1);
+            m_data[index] = copy;
+            ++m_size;
+            return m_data + index;
+        }
+
+        /**
+         *  \brief  Insert a range of elements.
+         *
+         *  The range must not be a part of this vector.
+         */
+        template <typename ForwardIterator>
+        void insert(iterator position, ForwardIterator first, ForwardIterator last) {
+            size_t index = position - m_data;
+            size_t count = std::distance(first, last);
+            if (!count)
+                return;
+
+            if (m_size + count > m_capacity)
+                reallocate(std::max(m_capacity * 2, m_size + count));
+
+            if (index < m_size)
+                std::copy_backward(m_data + index, m_data + m_size, m_data + m_size + count);
+
+            std::copy(first, last, m_data + index);
+            m_size += count;
+        }
+
+        iterator erase(iterator position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(iterator first, iterator last) {
+            iterator it = std::copy(last, end(), first);
+            m_size = it - m_data;
+            return first;
+        }
+
+        void swap(SmallVector& rhs) {
+            if (isInline() && rhs.isInline()) {
+                // Only the elements in use, the rest of the slots is uninitialized
+                SmallVector& longer = (m_size < rhs.m_size) ? rhs : *this;
+                SmallVector& shorter = (m_size < rhs.m_size) ? *this : rhs;
+                std::swap_ranges(shorter.m_inline, shorter.m_inline + shorter.m_size, longer.m_inline);
+                std::copy(longer.m_inline + shorter.m_size, longer.m_inline + longer.m_size, shorter.m_inline + shorter.m_size);
+                std::swap(m_size, rhs.m_size);
+                return;
+            }
+
+            if (!isInline() && !rhs.isInline()) {
+                std::swap(m_data, rhs.m_data);
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_capacity, rhs.m_capacity);
+                return;
+            }
+
+            // The heap storage changes hands, inline elements are copied
+            SmallVector& heap = (isInline()) ? rhs : *this;
+            SmallVector& small = (isInline()) ? *this : rhs;
+
+            T* data = heap.m_data;
+            size_t size = heap.m_size;
+            size_t capacity = heap.m_capacity;
+
+            std::copy(small.m_data, small.m_data + small.m_size, heap.m_inline);
+            heap.m_data = heap.m_inline;
+            heap.m_size = small.m_size;
+            heap.m_capacity = N;
+
+            small.m_data = data;
+            small.m_size = size;
+            small.m_capacity = capacity;
+        }
+
+    private:
+        T* m_data;
+        size_t m_size;
+        size_t m_capacity;
+        T m_inline[N];
+
+        /** Replace the elements with the elements of another vector */
+        void copy(const SmallVector& rhs) {
+            m_size = 0;
+            reserve(rhs.m_size);
+            std::copy(rhs.m_data, rhs.m_data + rhs.m_size, m_data);
+            m_size = rhs.m_size;
+        }
+
+        /** Move the elements to a heap storage of given capacity */
+        void reallocate(size_t capacity) {
+            T* data = new T[capacity];
+            std::copy(m_data, m_data + m_size, data);
+            release();
+
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        void release() {
+            if (!isInline())
+                delete [] m_data;
+        }
+    };
+}
+
+#endif
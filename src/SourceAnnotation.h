@@ -114,7 +114,8 @@ namespace snowcrash {
         NoError = 0,
         ApplicationError = 1,
         BusinessError = 2,
-        SymbolError = 3
+        SymbolError = 3,
+        BudgetError = 4
     };
     
     /**
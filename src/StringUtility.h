@@ -30,13 +30,13 @@ namespace snowcrash {
 
     // Trim string from start
     inline std::string& TrimStringStart(std::string &s) {
-        s.erase(s.begin(), std::find_if(s.begin(), s.end(), std::not1(std::ptr_fun(isSpace))));
+        s.erase(s.begin(), std::find_if_not(s.begin(), s.end(), isSpace));
         return s;
     }
     
     // Trim string from end
     inline std::string& TrimStringEnd(std::string &s) {
-        s.erase(std::find_if(s.rbegin(), s.rend(), std::not1(std::ptr_fun(isSpace))).base(), s.end());
+        s.erase(std::find_if_not(s.rbegin(), s.rend(), isSpace).base(), s.end());
         return s;
     }
     
@@ -86,6 +86,32 @@ namespace snowcrash {
     }
     
     
+    // FNV-1a parameters for the size of the hash
+    template<size_t Size>
+    struct FNVParameters;
+    
+    template<>
+    struct FNVParameters<4> {
+        static const unsigned long long OffsetBasis = 2166136261ull;
+        static const unsigned long long Prime = 16777619ull;
+    };
+    
+    template<>
+    struct FNVParameters<8> {
+        static const unsigned long long OffsetBasis = 14695981039346656037ull;
+        static const unsigned long long Prime = 1099511628211ull;
+    };
+    
+    // FNV-1a hash of given bytes, 32 or 64-bit depending on the size of size_t
+    inline size_t HashString(const char* data, size_t length) {
+        size_t hash = static_cast<size_t>(FNVParameters<sizeof(size_t)>::OffsetBasis);
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= static_cast<size_t>(FNVParameters<sizeof(size_t)>::Prime);
+        }
+        return hash;
+    }
+    
     /**
      *  \brief  Replace all occurrences of a string.
      *  \param  s       A string to search in.
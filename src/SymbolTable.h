@@ -10,8 +10,11 @@
 #define SNOWCRASH_SYMBOLTABLE_H
 
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "RegexMatch.h"
+#include "ParserCore.h"
 
 #ifdef DEBUG
 #include <iostream>
@@ -35,27 +38,170 @@ namespace snowcrash {
     // Name of a symbol
     typedef SourceData SymbolName;
     
+    // Normalized name of a symbol, trimmed and hashed once
+    struct SymbolKey {
+        SymbolKey() : hash(HashString(NULL, 0)) {}
+        SymbolKey(const SymbolName& symbol) : name(symbol) { normalize(); }
+        SymbolKey(const char* symbol) : name(symbol) { normalize(); }
+        
+        // Trimmed name
+        SymbolName name;
+        
+        // Hash of the trimmed name
+        size_t hash;
+        
+        bool operator==(const SymbolKey& rhs) const {
+            return hash == rhs.hash && name == rhs.name;
+        }
+        
+        // Key of a name already trimmed, e.g. by GetSymbolReference(), only hashes the name
+        static SymbolKey Normalized(const SymbolName& symbol) {
+            SymbolKey key;
+            key.name = symbol;
+            key.hash = HashString(key.name.data(), key.name.length());
+            return key;
+        }
+        
+    private:
+        void normalize() {
+            TrimString(name);
+            hash = HashString(name.data(), name.length());
+        }
+    };
+    
+    // Hash of a symbol key, computed by the key
+    struct SymbolKeyHash {
+        size_t operator()(const SymbolKey& key) const { return key.hash; }
+    };
+    
     // Resource Object Symbol
     typedef std::pair<SymbolName, ResourceModel> ResourceModelSymbol;
     
     // Resource Object Symbol Table
-    typedef std::map<SymbolName, ResourceModel> ResourceModelSymbolTable;
+    typedef std::unordered_map<SymbolKey, ResourceModel, SymbolKeyHash> ResourceModelSymbolTable;
+    
+    // Sizes of Resource Object Symbols
+    typedef std::unordered_map<SymbolKey, size_t, SymbolKeyHash> ResourceModelSizes;
+    
+    // Reference to a Resource Object Symbol
+    struct ResourceModelReference {
+        
+        // Normalized name of the referred symbol
+        SymbolKey symbol;
+        
+        // Source map of the reference
+        SourceDataBlock sourceMap;
+    };
+    
+    // Resource Object Symbol References
+    typedef std::vector<ResourceModelReference> ResourceModelReferences;
+    
+    // Names of Resource Object Symbols
+    typedef std::unordered_set<SymbolKey, SymbolKeyHash> ResourceModelNames;
     
     struct SymbolTable {
+        SymbolTable() : modelNamesCollected(false) {}
         
         // Resource Object Symbol Table
         ResourceModelSymbolTable resourceModels;
+        
+        // Description bytes of the models as spent from the parser budget when defined,
+        // the same whether the descriptions are retrieved or only validated
+        ResourceModelSizes modelDescriptionBytes;
+        
+        // References to models not defined at the point of the reference, in the document order
+        ResourceModelReferences forwardReferences;
+        
+        // Names of the models defined anywhere in the document, collected on the first
+        // reference to a model not defined yet, see CollectResourceModelNames()
+        ResourceModelNames modelNames;
+        bool modelNamesCollected;
+        
+        // Definitions of the models, in the document order
+        ResourceModelReferences definitions;
+        
+        // All references to models, in the document order
+        ResourceModelReferences references;
+    };
+    
+    // Definition and references of a symbol
+    struct SymbolIndexEntry {
+        
+        // Location of the definition, empty if the symbol is not defined
+        SourceCharactersBlock definition;
+        
+        // Locations of the references, in the document order
+        std::vector<SourceCharactersBlock> references;
+        
+        // Number of references to the symbol
+        size_t referenceCount() const { return references.size(); }
     };
     
+    // Index of the symbols of a blueprint, e.g. to find models never referred
+    typedef std::unordered_map<SymbolKey, SymbolIndexEntry, SymbolKeyHash> SymbolIndex;
+    
+    // Builds the symbol index out of a symbol table of a parsed blueprint.
+    FORCEINLINE void BuildSymbolIndex(const SymbolTable& symbolTable,
+                                      const SourceData& sourceData,
+                                      SymbolIndex& symbolIndex) {
+        
+        symbolIndex.clear();
+        
+        for (ResourceModelReferences::const_iterator it = symbolTable.definitions.begin();
+             it != symbolTable.definitions.end();
+             ++it)
+            symbolIndex[it->symbol].definition = MapSourceDataBlock(it->sourceMap, sourceData);
+        
+        for (ResourceModelReferences::const_iterator it = symbolTable.references.begin();
+             it != symbolTable.references.end();
+             ++it)
+            symbolIndex[it->symbol].references.push_back(MapSourceDataBlock(it->sourceMap, sourceData));
+    }
+    
+    // Returns model of given name, NULL if there is no such model defined yet.
+    FORCEINLINE const ResourceModel* FindResourceModel(const SymbolTable& symbolTable,
+                                                       const SymbolKey& symbol) {
+        
+        ResourceModelSymbolTable::const_iterator it = symbolTable.resourceModels.find(symbol);
+        if (it != symbolTable.resourceModels.end())
+            return &it->second;
+        
+        return NULL;
+    }
+    
+    // Returns description bytes spent on a model when it was defined, 0 if not defined.
+    FORCEINLINE size_t ResourceModelDescriptionBytes(const SymbolTable& symbolTable,
+                                                     const SymbolKey& symbol) {
+        
+        ResourceModelSizes::const_iterator it = symbolTable.modelDescriptionBytes.find(symbol);
+        if (it != symbolTable.modelDescriptionBytes.end())
+            return it->second;
+        
+        return 0;
+    }
+    
+    // Resolves a model into a payload that referred to it before the model was defined.
+    // The model's content precedes the payload's own, the body and schema are shared
+    // with the model, not copied.
+    FORCEINLINE void ResolveResourceModelReference(const ResourceModel& model,
+                                                   Payload& payload) {
+        
+        payload.description.insert(0, model.description);
+        payload.parameters.insert(payload.parameters.begin(), model.parameters.begin(), model.parameters.end());
+        payload.headers.insert(payload.headers.begin(), model.headers.begin(), model.headers.end());
+        payload.body = model.body;
+        payload.schema = model.schema;
+    }
+    
     
     // Checks whether given source data represents reference to a symbol returning true if so,
     // false otherwise. If source data is represent reference referred symbol name is filled in.
     FORCEINLINE bool GetSymbolReference(const SourceData& sourceData,
                                         SymbolName& referredSymbol) {
         
-        CaptureGroups captureGroups;
-        if (RegexCapture(sourceData, snowcrashconst::SymbolReferenceRegex, captureGroups, 3)) {
-            referredSymbol = captureGroups[1];
+        CaptureRanges captureRanges;
+        if (RegexCaptureRanges(sourceData, snowcrashconst::SymbolReferenceRegex, captureRanges, 2)) {
+            referredSymbol = CaptureRangeString(sourceData, captureRanges[1]);
             TrimString(referredSymbol);
             return true;
         }
@@ -71,7 +217,7 @@ namespace snowcrash {
              it != symbolTable.resourceModels.end();
              ++it) {
             
-            std::cout << "- " << it->first << " - body: '" << EscapeNewlines(it->second.body) << "'\n";
+            std::cout << "- " << it->first.name << " - body: '" << EscapeNewlines(it->second.body) << "'\n";
         }
         
         std::cout << std::endl;
@@ -0,0 +1,256 @@
+//
+//  UTF8.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include <atomic>
+#include "UTF8.h"
+
+//
+// SSE2 is a part of every x86-64 CPU, it is used whenever the compiler targets it.
+// AVX2 is compiled in for the particular function only and selected at runtime.
+//
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define UTF8_SSE2
+#   include <emmintrin.h>
+#endif
+
+#if defined(UTF8_SSE2)
+#   if defined(_MSC_VER)
+#       if _MSC_VER >= 1700
+#           define UTF8_AVX2
+#           define UTF8_AVX2_TARGET
+#           include <immintrin.h>
+#           include <intrin.h>
+#       endif
+#   elif defined(__clang__)
+#       if defined(__has_builtin)
+#           if __has_builtin(__builtin_cpu_supports)
+#               define UTF8_AVX2
+#               define UTF8_AVX2_TARGET __attribute__((target("avx2")))
+#               include <immintrin.h>
+#           endif
+#       endif
+#   elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#       define UTF8_AVX2
+#       define UTF8_AVX2_TARGET __attribute__((target("avx2")))
+#       include <immintrin.h>
+#   endif
+#endif
+
+using namespace snowcrash;
+
+/** Character counting function */
+typedef size_t (*CountFunction)(const char* data, size_t length);
+
+static size_t CountScalar(const char* data, size_t length)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i)
+        count += ((static_cast<unsigned char>(data[i]) & 0xC0) != 0x80);
+
+    return count;
+}
+
+#if defined(UTF8_SSE2)
+
+/** Maximum number of vectors accumulated in 8-bit lanes */
+static const size_t MaxAccumulatedVectors = 255;
+
+/** \return Sum of the 16-bit counts in the low and high 64-bit lanes */
+static inline size_t SumLanes(__m128i sums)
+{
+    return static_cast<size_t>(_mm_cvtsi128_si32(sums)) +
+           static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+}
+
+static size_t CountSSE2(const char* data, size_t length)
+{
+    // Continuation bytes are the signed bytes below -64 (0xC0)
+    const __m128i lastContinuation = _mm_set1_epi8(static_cast<char>(0xBF));
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t count = 0, i = 0;
+    while (length - i >= 16) {
+
+        size_t vectors = (length - i) / 16;
+        if (vectors > MaxAccumulatedVectors)
+            vectors = MaxAccumulatedVectors;
+
+        // Each non-continuation byte subtracts -1 from its lane
+        __m128i accumulator = zero;
+        for (size_t v = 0; v < vectors; ++v, i += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            accumulator = _mm_sub_epi8(accumulator, _mm_cmpgt_epi8(bytes, lastContinuation));
+        }
+
+        count += SumLanes(_mm_sad_epu8(accumulator, zero));
+    }
+
+    return count + CountScalar(data + i, length - i);
+}
+
+#endif
+
+#if defined(UTF8_AVX2)
+
+UTF8_AVX2_TARGET
+static size_t CountAVX2(const char* data, size_t length)
+{
+    const __m256i lastContinuation = _mm256_set1_epi8(static_cast<char>(0xBF));
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t count = 0, i = 0;
+    while (length - i >= 32) {
+
+        size_t vectors = (length - i) / 32;
+        if (vectors > MaxAccumulatedVectors)
+            vectors = MaxAccumulatedVectors;
+
+        __m256i accumulator = zero;
+        for (size_t v = 0; v < vectors; ++v, i += 32) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            accumulator = _mm256_sub_epi8(accumulator, _mm256_cmpgt_epi8(bytes, lastContinuation));
+        }
+
+        __m256i sums = _mm256_sad_epu8(accumulator, zero);
+        count += SumLanes(_mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1)));
+    }
+
+    return count + CountSSE2(data + i, length - i);
+}
+
+/** \return True if the CPU and OS support AVX2 */
+static bool HasAVX2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // OSXSAVE and AVX, the OS saves YMM registers
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/**
+ *  AVX2 support, -1 until probed on the first use. An atomic for the same
+ *  reason as %SelectedCountFunction, concurrent probes store the very same
+ *  value.
+ */
+static std::atomic<int> AVX2Support(-1);
+
+static bool SupportsAVX2()
+{
+    int support = AVX2Support.load(std::memory_order_acquire);
+    if (support < 0) {
+        support = HasAVX2() ? 1 : 0;
+        AVX2Support.store(support, std::memory_order_release);
+    }
+
+    return support != 0;
+}
+
+#endif
+
+bool snowcrash::IsUTF8CountKernelSupported(UTF8CountKernel kernel)
+{
+    switch (kernel) {
+        case ScalarUTF8CountKernel:
+            return true;
+
+#if defined(UTF8_SSE2)
+        case SSE2UTF8CountKernel:
+            return true;
+#endif
+
+#if defined(UTF8_AVX2)
+        case AVX2UTF8CountKernel:
+            return SupportsAVX2();
+#endif
+
+        default:
+            return false;
+    }
+}
+
+/** \return Counting function of a kernel, scalar if not supported */
+static CountFunction KernelFunction(UTF8CountKernel kernel)
+{
+    if (!IsUTF8CountKernelSupported(kernel))
+        return CountScalar;
+
+    switch (kernel) {
+#if defined(UTF8_SSE2)
+        case SSE2UTF8CountKernel:
+            return CountSSE2;
+#endif
+
+#if defined(UTF8_AVX2)
+        case AVX2UTF8CountKernel:
+            return CountAVX2;
+#endif
+
+        default:
+            return CountScalar;
+    }
+}
+
+UTF8CountKernel snowcrash::GetUTF8CountKernel()
+{
+    if (IsUTF8CountKernelSupported(AVX2UTF8CountKernel))
+        return AVX2UTF8CountKernel;
+
+    if (IsUTF8CountKernelSupported(SSE2UTF8CountKernel))
+        return SSE2UTF8CountKernel;
+
+    return ScalarUTF8CountKernel;
+}
+
+/**
+ *  Selected counting function, resolved on the first use. An atomic rather
+ *  than a function-local static, the Xcode build disables thread-safe
+ *  statics. Concurrent first uses store the very same function.
+ */
+static std::atomic<CountFunction> SelectedCountFunction(NULL);
+
+static CountFunction SelectedCount()
+{
+    CountFunction count = SelectedCountFunction.load(std::memory_order_acquire);
+    if (!count) {
+        count = KernelFunction(GetUTF8CountKernel());
+        SelectedCountFunction.store(count, std::memory_order_release);
+    }
+
+    return count;
+}
+
+size_t snowcrash::CountUTF8Characters(const char* data, size_t length)
+{
+    if (!data || !length)
+        return 0;
+
+    return SelectedCount()(data, length);
+}
+
+size_t snowcrash::CountUTF8Characters(const char* data, size_t length, UTF8CountKernel kernel)
+{
+    if (!data || !length)
+        return 0;
+
+    return KernelFunction(kernel)(data, length);
+}
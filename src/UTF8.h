@@ -0,0 +1,55 @@
+//
+//  UTF8.h
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#ifndef SNOWCRASH_UTF8_H
+#define SNOWCRASH_UTF8_H
+
+#include <cstddef>
+
+namespace snowcrash {
+
+    /**
+     *  \brief  UTF-8 character counting kernels.
+     */
+    enum UTF8CountKernel {
+        ScalarUTF8CountKernel = 0,  /// < Byte by byte, available everywhere
+        SSE2UTF8CountKernel,        /// < 16 bytes at a time, x86 with SSE2
+        AVX2UTF8CountKernel         /// < 32 bytes at a time, x86 with AVX2
+    };
+
+    /**
+     *  \brief  Count UTF-8 characters in a byte buffer.
+     *
+     *  Characters are counted as the bytes that are not UTF-8
+     *  continuation bytes (10xxxxxx). A NUL byte counts as
+     *  a character.
+     *
+     *  The fastest kernel supported by the CPU is selected on the
+     *  first call.
+     *
+     *  \param  data    A byte buffer to count characters in.
+     *  \param  length  Length of the buffer in bytes.
+     *  \return Number of characters in the buffer.
+     */
+    size_t CountUTF8Characters(const char* data, size_t length);
+
+    /**
+     *  \brief  Count UTF-8 characters in a byte buffer using given kernel.
+     *
+     *  Falls back to the scalar kernel if the requested one
+     *  is not supported.
+     */
+    size_t CountUTF8Characters(const char* data, size_t length, UTF8CountKernel kernel);
+
+    /** \return True if the kernel is built in and supported by the CPU */
+    bool IsUTF8CountKernelSupported(UTF8CountKernel kernel);
+
+    /** \return The kernel used by %CountUTF8Characters() */
+    UTF8CountKernel GetUTF8CountKernel();
+}
+
+#endif
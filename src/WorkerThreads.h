@@ -0,0 +1,38 @@
+//
+//  WorkerThreads.h
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#ifndef SNOWCRASH_WORKERTHREADS_H
+#define SNOWCRASH_WORKERTHREADS_H
+
+#include <cstddef>
+
+namespace snowcrash {
+
+    /**
+     *  \brief  Function run by a worker.
+     *  \param  worker  Index of the worker, from 0 to the number of workers.
+     *  \param  data    User data given to %RunWorkers().
+     */
+    typedef void (*WorkerFunction)(size_t worker, void* data);
+
+    /**
+     *  \brief  Run a function on a number of workers and wait for them to finish.
+     *
+     *  The calling thread runs the first worker, the other ones run
+     *  in threads started by the call and joined before it returns,
+     *  no threads are kept between the calls. A worker whose thread
+     *  cannot be started runs in the calling thread once the others
+     *  are finished.
+     *  The function must not throw.
+     */
+    void RunWorkers(WorkerFunction function, void* data, size_t count);
+
+    /** \return Number of processors available, at least 1 */
+    size_t WorkerConcurrency();
+}
+
+#endif
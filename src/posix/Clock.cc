@@ -0,0 +1,23 @@
+//
+//  Clock.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <time.h>
+#include <sys/time.h>
+#include "Clock.h"
+
+size_t snowcrash::ClockMilliseconds()
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    if (::clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        return static_cast<size_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+#endif
+
+    struct timeval tv;
+    ::gettimeofday(&tv, NULL);
+    return static_cast<size_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
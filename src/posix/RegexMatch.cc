@@ -7,41 +7,181 @@
 //
 
 #include <regex.h>
+#include <pthread.h>
 #include <cstring>
+#include <map>
 #include "RegexMatch.h"
 
-// FIXME: Migrate to C++11.
-// Naive implementation of regex matching using POSIX regex
-bool snowcrash::RegexMatch(const std::string& target, const std::string& expression)
-{
-    if (target.empty() || expression.empty())
-        return false;
+using namespace snowcrash;
+
+const size_t snowcrash::RegexCacheCapacity = 64;
 
+/**
+ *  A compiled expression shared by the cache and its current users.
+ *  The expression is freed when the last reference is released.
+ */
+struct CompiledRegex {
     regex_t regex;
-    int reti = ::regcomp(&regex, expression.c_str(), REG_EXTENDED | REG_NOSUB);
-    if (reti) {
+    size_t refCount;
+    unsigned long lastUse;
+};
+
+typedef std::map<std::string, CompiledRegex*> CompiledRegexMap;
+
+// Process-wide cache of compiled expressions, guarded by s_regexCacheMutex
+static pthread_mutex_t s_regexCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static CompiledRegexMap* s_regexCache = NULL;
+static RegexCacheStatistics s_regexCacheStatistics = { 0, 0, 0, 0, 0 };
+static unsigned long s_regexCacheClock = 0;
+
+/** Scoped lock of the regex cache */
+class RegexCacheLock {
+public:
+    RegexCacheLock() { ::pthread_mutex_lock(&s_regexCacheMutex); }
+    ~RegexCacheLock() { ::pthread_mutex_unlock(&s_regexCacheMutex); }
+    
+private:
+    RegexCacheLock(const RegexCacheLock&);
+    RegexCacheLock& operator=(const RegexCacheLock&);
+};
+
+// Releases one reference, the cache lock MUST be held
+static void ReleaseCompiledRegex(CompiledRegex* compiled)
+{
+    if (--compiled->refCount)
+        return;
+
+    ::regfree(&compiled->regex);
+    delete compiled;
+}
+
+// Drops the least recently used expression, the cache lock MUST be held
+static void EvictCompiledRegex()
+{
+    if (s_regexCache->empty())
+        return;
+    
+    CompiledRegexMap::iterator victim = s_regexCache->begin();
+    for (CompiledRegexMap::iterator it = s_regexCache->begin(); it != s_regexCache->end(); ++it) {
+        if (it->second->lastUse < victim->second->lastUse)
+            victim = it;
+    }
+    
+    ReleaseCompiledRegex(victim->second);
+    s_regexCache->erase(victim);
+    ++s_regexCacheStatistics.evictions;
+}
+
+// Returns compiled expression with one reference taken or NULL if the expression doesn't compile
+static CompiledRegex* AcquireCompiledRegex(const std::string& expression)
+{
+    {
+        RegexCacheLock lock;
+        if (!s_regexCache)
+            s_regexCache = new CompiledRegexMap;
+        
+        CompiledRegexMap::iterator it = s_regexCache->find(expression);
+        if (it != s_regexCache->end()) {
+            ++s_regexCacheStatistics.hits;
+            it->second->lastUse = ++s_regexCacheClock;
+            ++it->second->refCount;
+            return it->second;
+        }
+        
+        ++s_regexCacheStatistics.misses;
+    }
+    
+    // Compile outside of the lock
+    CompiledRegex* compiled = new CompiledRegex;
+    if (::regcomp(&compiled->regex, expression.c_str(), REG_EXTENDED)) {
         // Unable to compile regex
-        return false;
+        delete compiled;
+        return NULL;
     }
+    compiled->refCount = 1;
     
-    // Execute regular expression
-    reti = ::regexec(&regex, target.c_str(), 0, NULL, 0);
-    if (!reti) {
-        ::regfree(&regex);
-        return true;
+    RegexCacheLock lock;
+    ++s_regexCacheStatistics.compiles;
+    
+    // Other thread might have been faster
+    CompiledRegexMap::iterator it = s_regexCache->find(expression);
+    if (it != s_regexCache->end()) {
+        ReleaseCompiledRegex(compiled);
+        it->second->lastUse = ++s_regexCacheClock;
+        ++it->second->refCount;
+        return it->second;
     }
-    else if (reti == REG_NOMATCH) {
-        ::regfree(&regex);
-        return false;
+    
+    if (s_regexCache->size() >= RegexCacheCapacity)
+        EvictCompiledRegex();
+    
+    ++compiled->refCount; // cache's own reference
+    compiled->lastUse = ++s_regexCacheClock;
+    s_regexCache->insert(std::make_pair(expression, compiled));
+    s_regexCacheStatistics.size = s_regexCache->size();
+    
+    return compiled;
+}
+
+/** Scoped reference to a cached compiled expression */
+class CompiledRegexRef {
+public:
+    explicit CompiledRegexRef(const std::string& expression)
+    : m_compiled(AcquireCompiledRegex(expression)) {}
+    
+    ~CompiledRegexRef() {
+        if (!m_compiled)
+            return;
+        
+        RegexCacheLock lock;
+        ReleaseCompiledRegex(m_compiled);
+    }
+    
+    /** \return Compiled expression or NULL if the expression is invalid */
+    const regex_t* regex() const {
+        return (m_compiled) ? &m_compiled->regex : NULL;
+    }
+    
+private:
+    CompiledRegex* m_compiled;
+    
+    CompiledRegexRef(const CompiledRegexRef&);
+    CompiledRegexRef& operator=(const CompiledRegexRef&);
+};
+
+RegexCacheStatistics snowcrash::GetRegexCacheStatistics()
+{
+    RegexCacheLock lock;
+    return s_regexCacheStatistics;
+}
+
+void snowcrash::ResetRegexCache()
+{
+    RegexCacheLock lock;
+    if (s_regexCache) {
+        for (CompiledRegexMap::iterator it = s_regexCache->begin(); it != s_regexCache->end(); ++it) {
+            ReleaseCompiledRegex(it->second);
+        }
+        s_regexCache->clear();
     }
-    else {
-        char msgbuf[1024];
-        regerror(reti, &regex, msgbuf, sizeof(msgbuf));
-        ::regfree(&regex);
+    
+    ::memset(&s_regexCacheStatistics, 0, sizeof(s_regexCacheStatistics));
+}
+
+bool snowcrash::RegexMatch(const std::string& target, const std::string& expression)
+{
+    if (target.empty() || expression.empty())
+        return false;
+
+    CompiledRegexRef compiled(expression);
+    if (!compiled.regex()) {
+        // Unable to compile regex
         return false;
     }
     
-    return false;
+    // Execute regular expression
+    int reti = ::regexec(compiled.regex(), target.c_str(), 0, NULL, 0);
+    return (reti == 0);
 }
 
 std::string snowcrash::RegexCaptureFirst(const std::string& target, const std::string& expression)
@@ -62,33 +202,29 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
     captureGroups.clear();
     
     try {
-        regex_t regex;
-        int reti = ::regcomp(&regex, expression.c_str(), REG_EXTENDED);
-        if (reti)
+        CompiledRegexRef compiled(expression);
+        if (!compiled.regex())
             return false;
         
-        regmatch_t *pmatch = ::new regmatch_t[groupSize];
+        // Use stack buffer unless there is too many groups
+        regmatch_t stackMatch[MaxCaptureRangesSize];
+        regmatch_t *pmatch = (groupSize > MaxCaptureRangesSize) ? ::new regmatch_t[groupSize] : stackMatch;
         ::memset(pmatch, 0, sizeof(regmatch_t) * groupSize);
         
-        reti = ::regexec(&regex, target.c_str(), groupSize, pmatch, 0);
+        int reti = ::regexec(compiled.regex(), target.c_str(), groupSize, pmatch, 0);
         if (!reti) {
-            ::regfree(&regex);
-            
             for (size_t i = 0; i < groupSize; ++i) {
                 if (pmatch[i].rm_so == -1 || pmatch[i].rm_eo == -1)
                     captureGroups.push_back(std::string());
                 else
                     captureGroups.push_back(std::string(target, pmatch[i].rm_so, pmatch[i].rm_eo - pmatch[i].rm_so));
             }
-            
-            delete [] pmatch;
-            return true;
-        }
-        else {
-            ::regfree(&regex);
-            delete [] pmatch;        
-            return false;
         }
+        
+        if (pmatch != stackMatch)
+            delete [] pmatch;
+        
+        return (reti == 0);
     }
     catch (...) {
     }
@@ -96,4 +232,50 @@ bool snowcrash::RegexCapture(const std::string& target, const std::string& expre
     return false;    
 }
 
+bool snowcrash::RegexCaptureRanges(const std::string& target, const std::string& expression, CaptureRanges& captureRanges, size_t groupSize)
+{
+    captureRanges.size = 0;
+    
+    if (target.empty() || expression.empty())
+        return false;
+    
+    if (groupSize > MaxCaptureRangesSize)
+        groupSize = MaxCaptureRangesSize;
+    
+    try {
+        CompiledRegexRef compiled(expression);
+        if (!compiled.regex())
+            return false;
+        
+        regmatch_t pmatch[MaxCaptureRangesSize];
+        if (::regexec(compiled.regex(), target.c_str(), groupSize, pmatch, 0) != 0)
+            return false;
+        
+        for (size_t i = 0; i < groupSize; ++i) {
+            CaptureRange& range = captureRanges.groups[i];
+            if (pmatch[i].rm_so == -1 || pmatch[i].rm_eo == -1) {
+                range.location = 0;
+                range.length = 0;
+            }
+            else {
+                range.location = pmatch[i].rm_so;
+                range.length = pmatch[i].rm_eo - pmatch[i].rm_so;
+            }
+        }
+        
+        captureRanges.size = groupSize;
+        return true;
+    }
+    catch (...) {
+    }
+    
+    return false;
+}
 
+std::string snowcrash::CaptureRangeString(const std::string& target, const CaptureRange& range)
+{
+    if (!range.length)
+        return std::string();
+    
+    return target.substr(range.location, range.length);
+}
@@ -0,0 +1,59 @@
+//
+//  WorkerThreads.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+#include "WorkerThreads.h"
+
+using namespace snowcrash;
+
+/** A worker run by a thread */
+struct Worker {
+    WorkerFunction function;
+    void* data;
+    size_t index;
+    pthread_t thread;
+    bool started;
+};
+
+static void* RunWorker(void* arg)
+{
+    Worker* worker = static_cast<Worker*>(arg);
+    worker->function(worker->index, worker->data);
+    return NULL;
+}
+
+void snowcrash::RunWorkers(WorkerFunction function, void* data, size_t count)
+{
+    if (!count)
+        return;
+    
+    std::vector<Worker> workers(count);
+    for (size_t i = 1; i < count; ++i) {
+        Worker& worker = workers[i];
+        worker.function = function;
+        worker.data = data;
+        worker.index = i;
+        worker.started = (::pthread_create(&worker.thread, NULL, RunWorker, &worker) == 0);
+    }
+    
+    function(0, data);
+    
+    for (size_t i = 1; i < count; ++i) {
+        if (workers[i].started)
+            ::pthread_join(workers[i].thread, NULL);
+        else
+            function(i, data);
+    }
+}
+
+size_t snowcrash::WorkerConcurrency()
+{
+    long count = ::sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 1) ? static_cast<size_t>(count) : 1;
+}
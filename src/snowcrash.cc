@@ -10,9 +10,45 @@
 
 using namespace snowcrash;
 
+const Asset snowcrash::EmptyAsset;
+
 int snowcrash::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint)
 {
     Parser p;
     p.parse(source, options, result, blueprint);
     return result.error.code;
 }
+
+int snowcrash::parse(const SourceData& source, BlueprintParserOptions options, const ParserBudget& budget, Result& result, Blueprint& blueprint)
+{
+    ParserContext context;
+    context.setBudget(budget);
+    
+    Parser p;
+    p.parse(source, options, result, blueprint, context);
+    return result.error.code;
+}
+
+int snowcrash::parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint, ParserContext& context)
+{
+    Parser p;
+    p.parse(source, options, result, blueprint, context);
+    return result.error.code;
+}
+
+int snowcrash::parse(const SourceData& source, BlueprintParserOptions options, Result& result, BlueprintArena& blueprint)
+{
+    Parser p;
+    Blueprint parsed;
+    p.parse(source, options, result, parsed);
+    blueprint.assign(parsed, source);
+    return result.error.code;
+}
+
+int snowcrash::validate(const SourceData& source, BlueprintParserOptions options, Result& result)
+{
+    Parser p;
+    Blueprint blueprint;
+    p.parse(source, options | ValidateOnlyOption, result, blueprint);
+    return result.error.code;
+}
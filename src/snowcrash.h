@@ -10,6 +10,7 @@
 #define SNOWCRASH_H
 
 #include "Parser.h"
+#include "BlueprintArena.h"
 
 /**
  *  API Blueprint Parser Interface
@@ -36,6 +37,55 @@ namespace snowcrash {
      *  \return Error status code. Zero represents success, non-zero a failure.
      */
     int parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint);
+    
+    /**
+     *  \brief Parse the source data within a budget.
+     *
+     *  Use when parsing untrusted documents. The parse stops with
+     *  the %BudgetError when it exceeds any limit of the budget.
+     *
+     *  \param budget        Limits of the parse, see %ParserBudget.
+     *  \return Error status code. Zero represents success, non-zero a failure.
+     */
+    int parse(const SourceData& source, BlueprintParserOptions options, const ParserBudget& budget, Result& result, Blueprint& blueprint);
+    
+    /**
+     *  \brief Parse the source data reusing a parser context.
+     *
+     *  Use when parsing many documents, a context keeps the parser
+     *  set up across the parses. Use one context per thread.
+     *
+     *  \param context       A parser context to reuse.
+     *  \return Error status code. Zero represents success, non-zero a failure.
+     */
+    int parse(const SourceData& source, BlueprintParserOptions options, Result& result, Blueprint& blueprint, ParserContext& context);
+    
+    /**
+     *  \brief Parse the source data into an AST held by an arena.
+     *
+     *  Use when keeping the AST of a large document with many repeated
+     *  values, see %BlueprintArena.
+     *
+     *  \param blueprint     Parsed blueprint AST, its strings point into
+     *                       the retained source or are interned in the arena.
+     *  \return Error status code. Zero represents success, non-zero a failure.
+     */
+    int parse(const SourceData& source, BlueprintParserOptions options, Result& result, BlueprintArena& blueprint);
+    
+    /**
+     *  \brief Validate the source data without building its AST.
+     *
+     *  Reports the very same result as %parse(), the parser budget spent
+     *  included, but does not retrieve descriptions and assets of the
+     *  blueprint. Equal to %parse() with the %ValidateOnlyOption,
+     *  discarding the AST.
+     *
+     *  \param source        A textual source data to be validated.
+     *  \param options       Parser options. Use 0 for no addtional options.
+     *  \param result        Validation result report.
+     *  \return Error status code. Zero represents success, non-zero a failure.
+     */
+    int validate(const SourceData& source, BlueprintParserOptions options, Result& result);
 }
 
 #endif
@@ -33,7 +33,10 @@ enum SerializationFormat {
 /// \brief Print Markdown source annotation.
 /// \param prefix A string prefix for the annotation
 /// \param annotation An annotation to print
-void PrintAnnotation(const std::string& prefix, const snowcrash::SourceAnnotation& annotation)
+/// \param sourceIndex Character index of the annotated source
+void PrintAnnotation(const std::string& prefix,
+                     const snowcrash::SourceAnnotation& annotation,
+                     const snowcrash::SourceCharacterIndex& sourceIndex)
 {
     std::cerr << prefix;
     
@@ -52,6 +55,10 @@ void PrintAnnotation(const std::string& prefix, const snowcrash::SourceAnnotatio
             std::cerr << ((it == annotation.location.begin()) ? " :" : ";");
             std::cerr << it->location << ":" << it->length;
         }
+        
+        size_t line, column;
+        sourceIndex.lineColumn(annotation.location.front().location, line, column);
+        std::cerr << " (line " << line << ", column " << column << ")";
     }
     
     std::cerr << std::endl;
@@ -59,7 +66,8 @@ void PrintAnnotation(const std::string& prefix, const snowcrash::SourceAnnotatio
 
 /// \brief Print parser result to stderr.
 /// \param result A parser result to print
-void PrintResult(const snowcrash::Result& result)
+/// \param sourceIndex Character index of the parsed source
+void PrintResult(const snowcrash::Result& result, const snowcrash::SourceCharacterIndex& sourceIndex)
 {
     std::cerr << std::endl;
     
@@ -67,11 +75,11 @@ void PrintResult(const snowcrash::Result& result)
         std::cerr << "OK.\n";
     }
     else {
-        PrintAnnotation("error:", result.error);
+        PrintAnnotation("error:", result.error, sourceIndex);
     }
     
     for (snowcrash::Warnings::const_iterator it = result.warnings.begin(); it != result.warnings.end(); ++it) {
-        PrintAnnotation("warning:", *it);
+        PrintAnnotation("warning:", *it, sourceIndex);
     }
 }
 
@@ -131,7 +139,16 @@ int main(int argc, const char *argv[])
     snowcrash::BlueprintParserOptions options = 0;  // Or snowcrash::RequireBlueprintNameOption
     snowcrash::Result result;
     snowcrash::Blueprint blueprint;
-    snowcrash::parse(inputStream.str(), options, result, blueprint);
+    snowcrash::SourceData sourceData = inputStream.str();
+    snowcrash::SourceCharacterIndex sourceIndex(sourceData);
+    {
+        // The parser maps the annotations with the active index, the index is reused to print them
+        snowcrash::SourceCharacterIndex::Scope sourceIndexScope(sourceIndex);
+        if (argumentParser.exist(ValidateArgument))
+            snowcrash::validate(sourceData, options, result);
+        else
+            snowcrash::parse(sourceData, options, result, blueprint);
+    }
     
     // Output
     if (!argumentParser.exist(ValidateArgument)) {
@@ -165,6 +182,6 @@ int main(int argc, const char *argv[])
     }
     
     // Result
-    PrintResult(result);
+    PrintResult(result, sourceIndex);
     return result.error.code;
 }
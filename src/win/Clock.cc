@@ -0,0 +1,14 @@
+//
+//  Clock.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <windows.h>
+#include "Clock.h"
+
+size_t snowcrash::ClockMilliseconds()
+{
+    return static_cast<size_t>(::GetTickCount());
+}
@@ -6,11 +6,14 @@
 //  Copyright (c) 2013 Apiary Inc. All rights reserved.
 //
 
+#include <windows.h>
 #include <regex>
 #include <cstring>
+#include <map>
 #include "RegexMatch.h"
 
 using namespace std;
+using namespace snowcrash;
 
 #if _MSC_VER == 1500
 using namespace std::tr1;
@@ -19,14 +22,170 @@ using namespace std::tr1;
 // A C++09 implementation
 //
 
+const size_t snowcrash::RegexCacheCapacity = 64;
+
+/**
+ *  A compiled expression shared by the cache and its current users.
+ *  The expression is freed when the last reference is released.
+ */
+struct CompiledRegex {
+    CompiledRegex(const string& expression)
+    : pattern(expression, regex_constants::extended), refCount(1), lastUse(0) {}
+    
+    regex pattern;
+    size_t refCount;
+    unsigned long lastUse;
+};
+
+typedef map<string, CompiledRegex*> CompiledRegexMap;
+
+/** Process-wide cache of compiled expressions */
+struct RegexCache {
+    RegexCache() : clock(0) {
+        ::InitializeCriticalSection(&lock);
+        ::memset(&statistics, 0, sizeof(statistics));
+    }
+    
+    CRITICAL_SECTION lock;
+    CompiledRegexMap expressions;
+    RegexCacheStatistics statistics;
+    unsigned long clock;
+};
+
+static RegexCache& GetRegexCache()
+{
+    static RegexCache cache;
+    return cache;
+}
+
+// Make sure the cache is constructed before any threads are around
+static RegexCache& s_regexCacheInit = GetRegexCache();
+
+/** Scoped lock of the regex cache */
+class RegexCacheLock {
+public:
+    RegexCacheLock() { ::EnterCriticalSection(&GetRegexCache().lock); }
+    ~RegexCacheLock() { ::LeaveCriticalSection(&GetRegexCache().lock); }
+    
+private:
+    RegexCacheLock(const RegexCacheLock&);
+    RegexCacheLock& operator=(const RegexCacheLock&);
+};
+
+// Releases one reference, the cache lock MUST be held
+static void ReleaseCompiledRegex(CompiledRegex* compiled)
+{
+    if (--compiled->refCount == 0)
+        delete compiled;
+}
+
+// Drops the least recently used expression, the cache lock MUST be held
+static void EvictCompiledRegex(RegexCache& cache)
+{
+    if (cache.expressions.empty())
+        return;
+    
+    CompiledRegexMap::iterator victim = cache.expressions.begin();
+    for (CompiledRegexMap::iterator it = cache.expressions.begin(); it != cache.expressions.end(); ++it) {
+        if (it->second->lastUse < victim->second->lastUse)
+            victim = it;
+    }
+    
+    ReleaseCompiledRegex(victim->second);
+    cache.expressions.erase(victim);
+    ++cache.statistics.evictions;
+}
+
+// Returns compiled expression with one reference taken, throws regex_error if the expression doesn't compile
+static CompiledRegex* AcquireCompiledRegex(const string& expression)
+{
+    RegexCache& cache = GetRegexCache();
+    {
+        RegexCacheLock lock;
+        CompiledRegexMap::iterator it = cache.expressions.find(expression);
+        if (it != cache.expressions.end()) {
+            ++cache.statistics.hits;
+            it->second->lastUse = ++cache.clock;
+            ++it->second->refCount;
+            return it->second;
+        }
+        
+        ++cache.statistics.misses;
+    }
+    
+    // Compile outside of the lock
+    CompiledRegex* compiled = new CompiledRegex(expression);
+    
+    RegexCacheLock lock;
+    ++cache.statistics.compiles;
+    
+    // Other thread might have been faster
+    CompiledRegexMap::iterator it = cache.expressions.find(expression);
+    if (it != cache.expressions.end()) {
+        ReleaseCompiledRegex(compiled);
+        it->second->lastUse = ++cache.clock;
+        ++it->second->refCount;
+        return it->second;
+    }
+    
+    if (cache.expressions.size() >= RegexCacheCapacity)
+        EvictCompiledRegex(cache);
+    
+    ++compiled->refCount; // cache's own reference
+    compiled->lastUse = ++cache.clock;
+    cache.expressions.insert(make_pair(expression, compiled));
+    cache.statistics.size = cache.expressions.size();
+    
+    return compiled;
+}
+
+/** Scoped reference to a cached compiled expression */
+class CompiledRegexRef {
+public:
+    explicit CompiledRegexRef(const string& expression)
+    : m_compiled(AcquireCompiledRegex(expression)) {}
+    
+    ~CompiledRegexRef() {
+        RegexCacheLock lock;
+        ReleaseCompiledRegex(m_compiled);
+    }
+    
+    const regex& pattern() const {
+        return m_compiled->pattern;
+    }
+    
+private:
+    CompiledRegex* m_compiled;
+    
+    CompiledRegexRef(const CompiledRegexRef&);
+    CompiledRegexRef& operator=(const CompiledRegexRef&);
+};
+
+RegexCacheStatistics snowcrash::GetRegexCacheStatistics()
+{
+    RegexCacheLock lock;
+    return GetRegexCache().statistics;
+}
+
+void snowcrash::ResetRegexCache()
+{
+    RegexCache& cache = GetRegexCache();
+    RegexCacheLock lock;
+    for (CompiledRegexMap::iterator it = cache.expressions.begin(); it != cache.expressions.end(); ++it) {
+        ReleaseCompiledRegex(it->second);
+    }
+    cache.expressions.clear();
+    ::memset(&cache.statistics, 0, sizeof(cache.statistics));
+}
+
 bool snowcrash::RegexMatch(const string& target, const string& expression)
 {
     if (target.empty() || expression.empty())
         return false;
     
     try {
-        regex pattern(expression, regex_constants::extended);
-        return regex_search(target, pattern);
+        CompiledRegexRef compiled(expression);
+        return regex_search(target, compiled.pattern());
     }
     catch (const regex_error&) {
     }
@@ -55,9 +214,9 @@ bool snowcrash::RegexCapture(const string& target, const string& expression, Cap
 
     try {
         
-        regex pattern(expression, regex_constants::extended);
+        CompiledRegexRef compiled(expression);
         match_results<string::const_iterator> result;
-        if (!regex_search(target, result, pattern))
+        if (!regex_search(target, result, compiled.pattern()))
             return false;
     
         for (match_results<string::const_iterator>::const_iterator it = result.begin();
@@ -76,3 +235,51 @@ bool snowcrash::RegexCapture(const string& target, const string& expression, Cap
     
     return false;
 }
+
+bool snowcrash::RegexCaptureRanges(const string& target, const string& expression, CaptureRanges& captureRanges, size_t groupSize)
+{
+    captureRanges.size = 0;
+    
+    if (target.empty() || expression.empty())
+        return false;
+    
+    if (groupSize > MaxCaptureRangesSize)
+        groupSize = MaxCaptureRangesSize;
+    
+    try {
+        
+        CompiledRegexRef compiled(expression);
+        match_results<string::const_iterator> result;
+        if (!regex_search(target, result, compiled.pattern()))
+            return false;
+        
+        for (size_t i = 0; i < groupSize; ++i) {
+            CaptureRange& range = captureRanges.groups[i];
+            if (i < result.size() && result[i].matched) {
+                range.location = result.position(i);
+                range.length = result.length(i);
+            }
+            else {
+                range.location = 0;
+                range.length = 0;
+            }
+        }
+        
+        captureRanges.size = groupSize;
+        return true;
+    }
+    catch (const regex_error&) {
+    }
+    catch (...) {
+    }
+    
+    return false;
+}
+
+string snowcrash::CaptureRangeString(const string& target, const CaptureRange& range)
+{
+    if (!range.length)
+        return string();
+    
+    return target.substr(range.location, range.length);
+}
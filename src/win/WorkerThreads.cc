@@ -0,0 +1,62 @@
+//
+//  WorkerThreads.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <windows.h>
+#include <process.h>
+#include <vector>
+#include "WorkerThreads.h"
+
+using namespace snowcrash;
+
+/** A worker run by a thread */
+struct Worker {
+    WorkerFunction function;
+    void* data;
+    size_t index;
+    HANDLE thread;
+};
+
+static unsigned __stdcall RunWorker(void* arg)
+{
+    Worker* worker = static_cast<Worker*>(arg);
+    worker->function(worker->index, worker->data);
+    return 0;
+}
+
+void snowcrash::RunWorkers(WorkerFunction function, void* data, size_t count)
+{
+    if (!count)
+        return;
+    
+    std::vector<Worker> workers(count);
+    for (size_t i = 1; i < count; ++i) {
+        Worker& worker = workers[i];
+        worker.function = function;
+        worker.data = data;
+        worker.index = i;
+        worker.thread = reinterpret_cast<HANDLE>(::_beginthreadex(NULL, 0, RunWorker, &worker, 0, NULL));
+    }
+    
+    function(0, data);
+    
+    for (size_t i = 1; i < count; ++i) {
+        if (workers[i].thread) {
+            ::WaitForSingleObject(workers[i].thread, INFINITE);
+            ::CloseHandle(workers[i].thread);
+        }
+        else {
+            function(i, data);
+        }
+    }
+}
+
+size_t snowcrash::WorkerConcurrency()
+{
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 1) ? static_cast<size_t>(info.dwNumberOfProcessors) : 1;
+}
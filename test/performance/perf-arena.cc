@@ -0,0 +1,203 @@
+//
+//  perf-arena.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+#include <cstdlib>
+#include <new>
+#include "cmdline.h"
+#include "snowcrash.h"
+#include "BlueprintArena.h"
+
+using namespace snowcrash;
+
+static const int TestRunCount = 5;
+
+/** Number of heap allocations and deallocations made so far */
+static size_t AllocationCount = 0;
+static size_t DeallocationCount = 0;
+
+/** Number of heap bytes allocated and not yet released */
+static size_t LiveBytes = 0;
+
+#if __cplusplus >= 201103L
+#   define NEW_THROW
+#else
+#   define NEW_THROW throw(std::bad_alloc)
+#endif
+
+/** Size prefix of a heap block, keeps the alignment of the block */
+static const size_t PrefixSize = 16;
+
+void* operator new(size_t size) NEW_THROW
+{
+    ++AllocationCount;
+    char* p = static_cast<char*>(::malloc(size + PrefixSize));
+    if (!p)
+        throw std::bad_alloc();
+
+    *reinterpret_cast<size_t*>(p) = size;
+    LiveBytes += size;
+    return p + PrefixSize;
+}
+
+void* operator new[](size_t size) NEW_THROW
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) throw()
+{
+    if (!p)
+        return;
+
+    char* block = static_cast<char*>(p) - PrefixSize;
+    ++DeallocationCount;
+    LiveBytes -= *reinterpret_cast<size_t*>(block);
+    ::free(block);
+}
+
+void operator delete[](void* p) throw()
+{
+    operator delete(p);
+}
+
+/** \return Number of live heap allocations */
+static size_t LiveAllocations()
+{
+    return AllocationCount - DeallocationCount;
+}
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/** Generate a blueprint of at least given size (bytes) */
+static std::string GenerateBlueprint(size_t size)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\nHOST: http://example.com\n\n# Arena API\nAn API of many resources.\n\n";
+
+    for (size_t r = 0; static_cast<size_t>(ss.tellp()) < size; ++r) {
+        if (r % 10 == 0)
+            ss << "# Group Group " << r / 10 << "\n\nResources of the group " << r / 10 << ".\n\n";
+
+        ss << "## Resource " << r << " [/resources/" << r << "/{id}{?limit}]\n";
+        ss << "A resource number " << r << ", with a *description*.\n\n";
+        ss << "+ Parameters\n";
+        ss << "    + id (required, number, `42`) ... Id of the resource\n";
+        ss << "    + limit (optional, number, `10`) ... Maximum number of items\n\n";
+        ss << "### Retrieve Resource " << r << " [GET]\n";
+        ss << "Retrieves the resource.\n\n";
+        ss << "+ Response 200 (application/json)\n";
+        ss << "    + Headers\n\n";
+        ss << "            X-Request-Id: " << r << "\n";
+        ss << "            Cache-Control: no-cache\n\n";
+        ss << "    + Body\n\n";
+        ss << "            { \"id\": " << r << ", \"name\": \"Resource " << r << "\", \"tags\": [\"a\", \"b\"] }\n\n";
+        ss << "### Delete Resource " << r << " [DELETE]\n";
+        ss << "+ Response 204\n\n";
+    }
+
+    return ss.str();
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-arena");
+    std::stringstream ss;
+    ss << "\n\n";
+    ss << "API Blueprint Arena AST Performance Test Tool\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+    argumentParser.add<size_t>("size", 's', "size of the generated blueprint in MiB", false, 10);
+
+    argumentParser.parse_check(argc, argv);
+
+    std::string source = GenerateBlueprint(argumentParser.get<size_t>("size") * 1024 * 1024);
+
+    std::cout << "running snowcrash arena AST performance test...\n";
+    std::cout << source.length() / 1024 << "KiB blueprint, " << TestRunCount << "-times:\n";
+
+    double parseTime = 0, destroyTime = 0, buildTime = 0, releaseTime = 0, materializeTime = 0;
+    size_t astAllocations = 0, arenaAllocations = 0, arenaFootprint = 0, slicedLength = 0, internedCount = 0;
+    size_t astBytes = 0, arenaBytes = 0;
+
+    for (int i = 0; i < TestRunCount; ++i) {
+
+        // Parse into the string AST
+        Result result;
+        Blueprint* blueprint = new Blueprint;
+        size_t liveBefore = LiveAllocations();
+        size_t bytesBefore = LiveBytes;
+        double start = now();
+        parse(source, 0, result, *blueprint);
+        parseTime += now() - start;
+
+        if (result.error.code != Error::OK) {
+            std::cerr << "fatal: parsing failed\n";
+            exit(EXIT_FAILURE);
+        }
+
+        // Build the arena AST out of it
+        size_t arenaBefore = LiveAllocations();
+        size_t arenaBytesBefore = LiveBytes;
+        start = now();
+        BlueprintArena* arena = new BlueprintArena(*blueprint, source);
+        buildTime += now() - start;
+        arenaAllocations = LiveAllocations() - arenaBefore;
+        arenaBytes = LiveBytes - arenaBytesBefore;
+        arenaFootprint = arena->memoryFootprint();
+        slicedLength = arena->slicedLength();
+        internedCount = arena->internedCount();
+
+        // Destroy the string AST
+        astAllocations = arenaBefore - liveBefore;
+        astBytes = arenaBytesBefore - bytesBefore;
+        start = now();
+        delete blueprint;
+        destroyTime += now() - start;
+
+        // Convert back
+        Blueprint materialized;
+        start = now();
+        arena->materialize(materialized);
+        materializeTime += now() - start;
+
+        // Destroy the arena AST
+        start = now();
+        delete arena;
+        releaseTime += now() - start;
+    }
+
+    std::cout << "string AST: parse " << parseTime / TestRunCount * 1000.0 << " ms, ";
+    std::cout << astAllocations << " allocations held, " << astBytes / 1024 << "KiB, ";
+    std::cout << "destroy " << destroyTime / TestRunCount * 1000.0 << " ms\n";
+
+    std::cout << "arena AST: build " << buildTime / TestRunCount * 1000.0 << " ms, ";
+    std::cout << arenaAllocations << " allocations held, " << arenaFootprint / 1024 << "KiB, ";
+    std::cout << slicedLength / 1024 << "KiB of strings sliced from the source, ";
+    std::cout << internedCount << " distinct strings interned, ";
+    std::cout << "destroy " << releaseTime / TestRunCount * 1000.0 << " ms\n";
+
+    if (astBytes)
+        std::cout << "memory reduction: " << 100.0 - arenaBytes * 100.0 / astBytes << "%\n";
+
+    std::cout << "materialize: " << materializeTime / TestRunCount * 1000.0 << " ms\n";
+    return EXIT_SUCCESS;
+}
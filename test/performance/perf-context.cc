@@ -0,0 +1,100 @@
+//
+//  perf-context.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <sys/time.h>
+#include "cmdline.h"
+#include "snowcrash.h"
+
+using namespace snowcrash;
+
+static const int TestRunCount = 10000;
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ *  \brief  Parse input @TestRunCount -times
+ *  \param  context A parser context to reuse, NULL to parse without one.
+ *  \param  resultCode  Result code of the last parse.
+ *  \return Number of documents parsed per second.
+ */
+static double testfunc(const std::string& input, ParserContext* context, int& resultCode)
+{
+    double start = now();
+
+    for (int i = 0; i < TestRunCount; ++i) {
+        Result result;
+        Blueprint blueprint;
+
+        if (context)
+            resultCode = snowcrash::parse(input, 0, result, blueprint, *context);
+        else
+            resultCode = snowcrash::parse(input, 0, result, blueprint);
+    }
+
+    return TestRunCount / (now() - start);
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-context");
+    std::stringstream ss;
+    ss << "<input file>\n\n";
+    ss << "API Blueprint Parser Context Reuse Performance Test Tool\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+
+    argumentParser.parse_check(argc, argv);
+    if (argumentParser.rest().size() != 1) {
+        std::cerr << "one input file expected\n";
+        exit(EXIT_FAILURE);
+    }
+
+    // Read fixture file
+    std::ifstream inputFileStream;
+    std::string inputFileName = argumentParser.rest().front();
+    inputFileStream.open(inputFileName.c_str());
+    if (!inputFileStream.is_open()) {
+        std::cerr << "fatal: unable to open input file '" << inputFileName << "'\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::stringstream inputStream;
+    inputStream << inputFileStream.rdbuf();
+    inputFileStream.close();
+
+    std::cout << "running snowcrash parser context performance test...\n";
+
+    int result = 0, contextResult = 0;
+    double throughput = testfunc(inputStream.str(), NULL, result);
+
+    ParserContext context;
+    double contextThroughput = testfunc(inputStream.str(), &context, contextResult);
+
+    std::cout << "parsing '" << inputFileName << "' " << TestRunCount << "-times (" << result << "):\n";
+    std::cout << "new parser: " << throughput << " documents/s\n";
+    std::cout << "reused context: " << contextThroughput << " documents/s\n";
+
+    if (result != contextResult) {
+        std::cerr << "fatal: parsing with context differs\n";
+        exit(EXIT_FAILURE);
+    }
+}
@@ -0,0 +1,172 @@
+//
+//  perf-models.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+#include <cstdlib>
+#include <new>
+#include "cmdline.h"
+#include "snowcrash.h"
+
+static const int TestRunCount = 10;
+
+/** Number of heap allocations made so far */
+static size_t AllocationCount = 0;
+
+#if __cplusplus >= 201103L
+#   define NEW_THROW
+#else
+#   define NEW_THROW throw(std::bad_alloc)
+#endif
+
+void* operator new(size_t size) NEW_THROW
+{
+    ++AllocationCount;
+    void* p = ::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    ::free(p);
+}
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/** Append a resource with a model of given body size */
+static void AppendModel(std::stringstream& ss, size_t model, size_t bodySize)
+{
+    ss << "## Model " << model << " [/models/" << model << "]\n";
+    ss << "+ Model (application/json)\n\n";
+    ss << "    Model " << model << " description.\n\n";
+    ss << "    + Body\n\n";
+
+    std::string line(72, 'x');
+    for (size_t size = 0; size < bodySize; size += line.length() + 13)
+        ss << "            " << line << "\n";
+
+    ss << "\n";
+}
+
+/**
+ *  \brief  Generate a blueprint with heavily reused models.
+ *  \param  models      Number of models.
+ *  \param  references  Number of resources referring each model.
+ *  \param  bodySize    Size of a model body (bytes).
+ *  \param  forward     True to define the models after the references.
+ */
+static std::string GenerateBlueprint(size_t models, size_t references, size_t bodySize, bool forward)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\n\n# Models API\n\n# Group Models\n\n";
+
+    if (!forward) {
+        for (size_t m = 0; m < models; ++m)
+            AppendModel(ss, m, bodySize);
+    }
+
+    for (size_t r = 0; r < references; ++r) {
+        for (size_t m = 0; m < models; ++m) {
+            ss << "## Reference " << r << " of " << m << " [/references/" << r << "/" << m << "]\n";
+            ss << "### Retrieve [GET]\n";
+            ss << "+ Response 200\n\n";
+            ss << "    [Model " << m << "][]\n\n";
+            ss << "### Update [PUT]\n";
+            ss << "+ Request\n\n";
+            ss << "    [Model " << m << "][]\n\n";
+            ss << "+ Response 204\n\n";
+        }
+    }
+
+    if (forward) {
+        for (size_t m = 0; m < models; ++m)
+            AppendModel(ss, m, bodySize);
+    }
+
+    return ss.str();
+}
+
+/**
+ *  \brief  Parse input @TestRunCount -times, report mean time and allocations
+ *  \return Result code of snowcrash::parse operation.
+ */
+static int testfunc(const char* name, const std::string& input, snowcrash::BlueprintParserOptions options)
+{
+    int resultCode = snowcrash::Error::OK;
+    size_t allocations = 0;
+    double start = now();
+
+    for (int i = 0; i < TestRunCount; ++i) {
+        snowcrash::Result result;
+        snowcrash::Blueprint blueprint;
+
+        size_t allocationsBefore = AllocationCount;
+        snowcrash::parse(input, options, result, blueprint);
+        allocations = AllocationCount - allocationsBefore;
+
+        resultCode = result.error.code;
+    }
+
+    double mean = (now() - start) / TestRunCount;
+    std::cout << name << ": " << mean * 1000.0 << " ms, " << allocations << " allocations\n";
+    return resultCode;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-models");
+    std::stringstream ss;
+    ss << "\n\n";
+    ss << "API Blueprint Resource Model Reference Performance Test Tool\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+    argumentParser.add<size_t>("models", 'm', "number of models", false, 10);
+    argumentParser.add<size_t>("references", 'r', "number of resources referring each model", false, 100);
+    argumentParser.add<size_t>("size", 's', "size of a model body in KiB", false, 16);
+
+    argumentParser.parse_check(argc, argv);
+
+    size_t models = argumentParser.get<size_t>("models");
+    size_t references = argumentParser.get<size_t>("references");
+    size_t bodySize = argumentParser.get<size_t>("size") * 1024;
+
+    std::string backward = GenerateBlueprint(models, references, bodySize, false);
+    std::string forward = GenerateBlueprint(models, references, bodySize, true);
+
+    std::cout << "running snowcrash resource model reference performance test...\n";
+    std::cout << models << " models of " << bodySize / 1024 << "KiB, " << references * 2 << " payloads referring each, ";
+    std::cout << backward.length() / 1024 << "KiB blueprint, " << TestRunCount << "-times:\n";
+
+    int backwardCode = testfunc("models defined first", backward, 0);
+    int forwardCode = testfunc("models defined last", forward, 0);
+    int validateCode = testfunc("validation only", backward, snowcrash::ValidateOnlyOption);
+
+    if (backwardCode != snowcrash::Error::OK ||
+        forwardCode != snowcrash::Error::OK ||
+        validateCode != snowcrash::Error::OK) {
+        std::cerr << "fatal: parsing failed\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+//
+//  perf-scaling.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+#include "cmdline.h"
+#include "snowcrash.h"
+
+/** Maximum nesting of lists, sundown refuses to nest deeper */
+static const size_t MaxListDepth = 15;
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/** Generator of a blueprint of given size */
+typedef std::string (*GenerateBlueprintFunction)(size_t size, size_t depth);
+
+/** Paragraphs of the blueprint description, the linear reference */
+static std::string GenerateParagraphs(size_t size, size_t depth)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\n\n# Paragraphs API\n\n";
+
+    for (size_t p = 0; p < size; ++p)
+        ss << "Paragraph " << p << " of the API description.\n\n";
+
+    return ss.str();
+}
+
+/** Resources spread across groups of four, every resource looked up for a duplicate */
+static std::string GenerateResources(size_t size, size_t depth)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\n\n# Resources API\n\n";
+
+    for (size_t r = 0; r < size; ++r) {
+        if (r % 4 == 0)
+            ss << "# Group Group " << r / 4 << "\n\n";
+
+        ss << "## Resource " << r << " [/resources/" << r << "]\n";
+        ss << "### Retrieve [GET]\n";
+        ss << "+ Response 204\n\n";
+    }
+
+    return ss.str();
+}
+
+/** Headers of one payload, every header line looked up for a duplicate */
+static std::string GenerateHeaders(size_t size, size_t depth)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\n\n# Headers API\n\n";
+    ss << "## Resource [/resource]\n";
+    ss << "### Retrieve [GET]\n";
+    ss << "+ Response 204\n";
+    ss << "    + Headers\n\n";
+
+    for (size_t h = 0; h < size; ++h)
+        ss << "            X-Header-" << h << ": " << h << "\n";
+
+    ss << "\n";
+    return ss.str();
+}
+
+/** Metadata keys, every eighth key is a duplicate */
+static std::string GenerateMetadata(size_t size, size_t depth)
+{
+    std::stringstream ss;
+    for (size_t m = 0; m < size; ++m) {
+        size_t key = (m % 8 == 7) ? m - 1 : m;
+        ss << "Key-" << key << ": " << m << "\n";
+    }
+
+    ss << "\n# Metadata API\n\n";
+    return ss.str();
+}
+
+/** Lists nested to the depth in a resource description, followed by a recognized section */
+static std::string GenerateNestedLists(size_t size, size_t depth)
+{
+    std::stringstream ss;
+    ss << "FORMAT: 1A\n\n# Nested Lists API\n\n";
+    ss << "## Resource [/resource]\n\n";
+
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t d = 0; d < depth; ++d)
+            ss << std::string(d * 4, ' ') << "+ Item " << i << " level " << d << "\n";
+    }
+
+    ss << "\n+ Parameters\n";
+    ss << "    + id (string) ... Resource id\n\n";
+    ss << "### Retrieve [GET]\n";
+    ss << "+ Response 204\n\n";
+    return ss.str();
+}
+
+/**
+ *  \brief  Parse input, best of given runs.
+ *  \return Time of the fastest run in seconds.
+ */
+static double testfunc(const std::string& input, size_t runs, int& resultCode)
+{
+    double best = 0;
+    for (size_t i = 0; i < runs; ++i) {
+        snowcrash::Result result;
+        snowcrash::Blueprint blueprint;
+
+        double start = now();
+        snowcrash::parse(input, 0, result, blueprint);
+        double elapsed = now() - start;
+
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+
+        resultCode = result.error.code;
+    }
+
+    return best;
+}
+
+/** Least squares fit of log(time) over log(parameter) */
+struct SlopeFit {
+    SlopeFit() : n(0), sumX(0), sumY(0), sumXX(0), sumXY(0) {}
+
+    double n, sumX, sumY, sumXX, sumXY;
+
+    void add(size_t parameter, double elapsed) {
+        double x = std::log(static_cast<double>(parameter));
+        double y = std::log(elapsed > 0 ? elapsed : 1e-6);
+        n += 1;
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+
+    double slope() const {
+        return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+    }
+};
+
+/** Parse generated input of given size and depth, report the time in the fit */
+static void testpoint(GenerateBlueprintFunction generate,
+                      size_t size,
+                      size_t depth,
+                      size_t parameter,
+                      size_t runs,
+                      SlopeFit& fit)
+{
+    int resultCode = snowcrash::Error::OK;
+    double elapsed = testfunc(generate(size, depth), runs, resultCode);
+
+    if (resultCode != snowcrash::Error::OK) {
+        std::cerr << "\nfatal: parsing failed\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << " " << parameter << ": " << elapsed * 1000.0 << " ms" << std::flush;
+    fit.add(parameter, elapsed);
+}
+
+/**
+ *  \brief  Parse inputs growing twice each step, fit the growth rate.
+ *  \return Least squares slope of log(time) over log(size).
+ *
+ *  A path linear in the input size has the slope of about one,
+ *  quadratic of about two.
+ */
+static double testcase(const char* name,
+                       GenerateBlueprintFunction generate,
+                       size_t size,
+                       size_t depth,
+                       size_t steps,
+                       size_t runs)
+{
+    SlopeFit fit;
+
+    std::cout << name << ":";
+    for (size_t step = 0; step < steps; ++step, size *= 2)
+        testpoint(generate, size, depth, size, runs, fit);
+
+    double slope = fit.slope();
+    std::cout << ", slope " << slope << "\n";
+    return slope;
+}
+
+/**
+ *  \brief  Parse inputs nested one level deeper each step, fit the growth rate.
+ *  \return Least squares slope of log(time) over log(depth).
+ *
+ *  The input grows linearly with the depth, a path revisiting
+ *  the enclosing levels for every level has the slope of about two.
+ */
+static double testdepth(const char* name,
+                        GenerateBlueprintFunction generate,
+                        size_t size,
+                        size_t maxDepth,
+                        size_t runs)
+{
+    SlopeFit fit;
+
+    std::cout << name << ":";
+    for (size_t depth = 1; depth <= maxDepth; ++depth)
+        testpoint(generate, size, depth, depth, runs, fit);
+
+    double slope = fit.slope();
+    std::cout << ", slope " << slope << "\n";
+    return slope;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-scaling");
+    std::stringstream ss;
+    ss << "\n\n";
+    ss << "API Blueprint Scaling Performance Test Tool\n\n";
+    ss << "Parses generated blueprints of growing size and fails if the parse time\n";
+    ss << "grows faster than the input, i.e. a path of the parser went superlinear.\n";
+    ss << "Nested lists are also parsed one level deeper each step up to the depth.\n\n";
+    ss << "The growth is compared with the growth of a reference blueprint of plain\n";
+    ss << "paragraphs, parsed in linear time, measured in the same run. The threshold\n";
+    ss << "is the slope of the reference, at least one, plus the margin.\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+    argumentParser.add<size_t>("size", 's', "initial number of resources, headers, metadata keys and list items", false, 500);
+    argumentParser.add<size_t>("depth", 'd', "maximum depth of nested lists, swept from one level", false, MaxListDepth);
+    argumentParser.add<size_t>("steps", 'n', "number of times the size doubles", false, 4);
+    argumentParser.add<size_t>("runs", 'r', "number of runs of each size, the fastest counts", false, 3);
+    argumentParser.add<double>("margin", 'm', "margin of the parse time growth slope over the reference slope", false, 0.5);
+
+    argumentParser.parse_check(argc, argv);
+
+    size_t size = argumentParser.get<size_t>("size");
+    size_t depth = argumentParser.get<size_t>("depth");
+    size_t steps = argumentParser.get<size_t>("steps");
+    size_t runs = argumentParser.get<size_t>("runs");
+    double margin = argumentParser.get<double>("margin");
+
+    if (size == 0 || steps < 2 || runs == 0) {
+        std::cerr << "size and runs must be positive, at least two steps expected\n";
+        exit(EXIT_FAILURE);
+    }
+
+    if (depth < 2 || depth > MaxListDepth) {
+        std::cerr << "depth of nested lists must be within 2 and " << MaxListDepth << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << "running snowcrash scaling performance test...\n";
+    std::cout << "sizes " << size << " to " << (size << (steps - 1)) << ", lists nested 1 to " << depth << " levels, ";
+    std::cout << "best of " << runs << " runs, slope margin " << margin << ":\n";
+
+    // Calibrate on the reference, the markdown parser and the machine included
+    double maxSlope = std::max(testcase("reference paragraphs", GenerateParagraphs, size, depth, steps, runs), 1.0) + margin;
+    std::cout << "maximum slope " << maxSlope << "\n";
+
+    const char* names[] = { "resources", "headers", "metadata", "nested lists" };
+    const GenerateBlueprintFunction generators[] = { GenerateResources, GenerateHeaders, GenerateMetadata, GenerateNestedLists };
+
+    bool superlinear = false;
+    for (size_t c = 0; c < sizeof(generators) / sizeof(generators[0]); ++c) {
+        if (testcase(names[c], generators[c], size, depth, steps, runs) > maxSlope) {
+            std::cerr << "fatal: " << names[c] << " parse time grows superlinearly\n";
+            superlinear = true;
+        }
+    }
+
+    if (testdepth("nested lists depth", GenerateNestedLists, size, depth, runs) > maxSlope) {
+        std::cerr << "fatal: nested lists parse time grows superlinearly with the depth\n";
+        superlinear = true;
+    }
+
+    return (superlinear) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+//
+//  perf-signature.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <sys/time.h>
+#include "cmdline.h"
+#include "ResourceGroupParser.h"
+#include "SignatureLexer.h"
+
+using namespace snowcrash;
+
+static const int TestRunCount = 1000;
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ *  \brief  Classify a line using the regular expressions.
+ *  \return Number of signatures matched.
+ */
+static int classifyRegex(const std::string& line)
+{
+    CaptureGroups captureGroups;
+    int matched = 0;
+
+    matched += RegexCapture(line, snowcrashconst::GroupHeaderRegex, captureGroups, 3);
+    matched += RegexCapture(line, snowcrashconst::ResourceHeaderRegex, captureGroups, 4);
+    matched += RegexCapture(line, snowcrashconst::NamedResourceHeaderRegex, captureGroups, 4);
+    matched += RegexCapture(line, snowcrashconst::ActionHeaderRegex, captureGroups, 3);
+    matched += RegexCapture(line, snowcrashconst::NamedActionHeaderRegex, captureGroups, 3);
+    matched += RegexCapture(line, snowcrashconst::RequestRegex, captureGroups, 5);
+    matched += RegexCapture(line, snowcrashconst::ResponseRegex, captureGroups, 5);
+    matched += RegexCapture(line, snowcrashconst::ObjectRegex, captureGroups, 5);
+    matched += RegexCapture(line, snowcrashconst::ModelRegex, captureGroups, 5);
+    matched += RegexMatch(line, snowcrashconst::HeadersRegex);
+    matched += RegexMatch(line, snowcrashconst::ParametersRegex);
+    matched += RegexMatch(line, snowcrashconst::BodyRegex);
+    matched += RegexMatch(line, snowcrashconst::SchemaRegex);
+    return matched;
+}
+
+/**
+ *  \brief  Classify a line using the signature lexer.
+ *  \return Number of signatures matched.
+ */
+static int classifyLexer(const std::string& line)
+{
+    SignatureToken first, second;
+    int matched = 0;
+
+    matched += LexResourceGroupHeader(line, first);
+    matched += LexResourceHeader(line, first, second);
+    matched += LexNamedResourceHeader(line, first, second);
+    matched += LexActionHeader(line, first, second);
+    matched += LexNamedActionHeader(line, first, second);
+    matched += LexRequestSignature(line, first, second);
+    matched += LexResponseSignature(line, first, second);
+    matched += LexObjectSignature(line, first, second);
+    matched += LexModelSignature(line, first, second);
+    matched += LexKeywordSignature(line, "header", true);
+    matched += LexKeywordSignature(line, "parameter", true);
+    matched += LexKeywordSignature(line, "body");
+    matched += LexKeywordSignature(line, "schema");
+    return matched;
+}
+
+/**
+ *  \brief  Query payload signature of a line the way the regular expressions do.
+ *  \return 1 if the line has a payload signature, 0 otherwise.
+ */
+static int classifyPayloadRegex(const std::string& line)
+{
+    CaptureGroups captureGroups;
+    if (RegexCapture(line, snowcrashconst::RequestRegex, captureGroups, 5) ||
+        RegexCapture(line, snowcrashconst::ResponseRegex, captureGroups, 5) ||
+        RegexCapture(line, snowcrashconst::ObjectRegex, captureGroups, 5) ||
+        RegexCapture(line, snowcrashconst::ModelRegex, captureGroups, 5))
+        return 1;
+
+    return 0;
+}
+
+/**
+ *  \brief  Query payload signature of a line with one lexer after another.
+ *  \return 1 if the line has a payload signature, 0 otherwise.
+ */
+static int classifyPayloadLexers(const std::string& line)
+{
+    SignatureToken name, mediaType;
+    if (LexRequestSignature(line, name, mediaType) ||
+        LexResponseSignature(line, name, mediaType) ||
+        LexObjectSignature(line, name, mediaType) ||
+        LexModelSignature(line, name, mediaType))
+        return 1;
+
+    return 0;
+}
+
+/**
+ *  \brief  Query payload signature of a line in a single pass.
+ *  \return 1 if the line has a payload signature, 0 otherwise.
+ */
+static int classifyPayloadDispatch(const std::string& line)
+{
+    SignatureToken name, mediaType;
+    return (LexPayloadSignature(line, name, mediaType) != NoPayloadKeyword) ? 1 : 0;
+}
+
+/**
+ *  \brief  Classify every line @TestRunCount -times
+ *  \return Mean time spent classifying one line (s).
+ */
+static double testfunc(const std::vector<std::string>& lines, int (*classify)(const std::string&), int& matched)
+{
+    double start = now();
+
+    for (int i = 0; i < TestRunCount; ++i) {
+        matched = 0;
+        for (std::vector<std::string>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+            matched += classify(*it);
+        }
+    }
+
+    return (now() - start) / (TestRunCount * lines.size());
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-signature");
+    std::stringstream ss;
+    ss << "<input file>\n\n";
+    ss << "API Blueprint Signature Classification Performance Test Tool\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+
+    argumentParser.parse_check(argc, argv);
+    if (argumentParser.rest().size() != 1) {
+        std::cerr << "one input file expected\n";
+        exit(EXIT_FAILURE);
+    }
+
+    // Read fixture file, stripping markdown header and list markers
+    std::ifstream inputFileStream;
+    std::string inputFileName = argumentParser.rest().front();
+    inputFileStream.open(inputFileName.c_str());
+    if (!inputFileStream.is_open()) {
+        std::cerr << "fatal: unable to open input file '" << inputFileName << "'\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(inputFileStream, line)) {
+        std::string::size_type pos = line.find_first_not_of(" \t#+-");
+        if (pos == std::string::npos)
+            continue;
+
+        lines.push_back(line.substr(pos));
+    }
+
+    inputFileStream.close();
+
+    if (lines.empty()) {
+        std::cerr << "fatal: no lines to classify in '" << inputFileName << "'\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << "running snowcrash signature classification performance test...\n";
+
+    int regexMatched = 0, lexerMatched = 0;
+    double regexMean = testfunc(lines, classifyRegex, regexMatched);
+    double lexerMean = testfunc(lines, classifyLexer, lexerMatched);
+
+    std::cout << "classifying " << lines.size() << " lines of '" << inputFileName << "' " << TestRunCount << "-times:\n";
+    std::cout << "regex: " << regexMean * 1000000000.0 << "ns per line (" << regexMatched << " matched)\n";
+    std::cout << "lexer: " << lexerMean * 1000000000.0 << "ns per line (" << lexerMatched << " matched)\n";
+
+    if (regexMatched != lexerMatched) {
+        std::cerr << "fatal: signature lexer and regex classification differ\n";
+        exit(EXIT_FAILURE);
+    }
+
+    int payloadRegexMatched = 0, payloadLexersMatched = 0, payloadDispatchMatched = 0;
+    double payloadRegexMean = testfunc(lines, classifyPayloadRegex, payloadRegexMatched);
+    double payloadLexersMean = testfunc(lines, classifyPayloadLexers, payloadLexersMatched);
+    double payloadDispatchMean = testfunc(lines, classifyPayloadDispatch, payloadDispatchMatched);
+
+    std::cout << "payload signature:\n";
+    std::cout << "regex: " << payloadRegexMean * 1000000000.0 << "ns per line (" << payloadRegexMatched << " matched)\n";
+    std::cout << "lexers: " << payloadLexersMean * 1000000000.0 << "ns per line (" << payloadLexersMatched << " matched)\n";
+    std::cout << "dispatch: " << payloadDispatchMean * 1000000000.0 << "ns per line (" << payloadDispatchMatched << " matched)\n";
+
+    if (payloadRegexMatched != payloadDispatchMatched ||
+        payloadLexersMatched != payloadDispatchMatched) {
+        std::cerr << "fatal: payload signature classification differs\n";
+        exit(EXIT_FAILURE);
+    }
+}
@@ -10,30 +10,62 @@
 #include <fstream>
 #include <sys/time.h>
 #include <cmath>
+#include <cstdlib>
+#include <new>
+#include <atomic>
 #include "cmdline.h"
 #include "snowcrash.h"
+#include "SignatureMemo.h"
 
 using snowcrash::SourceAnnotation;
 using snowcrash::Error;
 
 static const int TestRunCount = 1000;
 
+/** Number of heap allocations made so far */
+static std::atomic<size_t> AllocationCount(0);
+
+#if __cplusplus >= 201103L
+#   define NEW_THROW
+#else
+#   define NEW_THROW throw(std::bad_alloc)
+#endif
+
+void* operator new(size_t size) NEW_THROW
+{
+    ++AllocationCount;
+    void* p = ::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    ::free(p);
+}
+
 /**
  *  \brief  Parse input @TestRunCount -times
  *  \param  input   A blueprint source data.
+ *  \param  options Parser options.
  *  \param  total   Total time spent parsing (s).
  *  \param  mean    Mean time spent parsing (s).
  *  \param  stddev  Standard deviation.
  *  \return Result code of snowcrash::parse operation.
  */
-static int testfunc(const std::string& input, double& total, double& mean, double& stddev)
+static int testfunc(const std::string& input,
+                    snowcrash::BlueprintParserOptions options,
+                    double& total,
+                    double& mean,
+                    double& stddev)
 {
 	struct timeval stime, etime;
 	double t = 0, sum = 0, sum2 = 0;
 	int resultCode = snowcrash::Error::OK;
 
 	for (int i = 0; i < TestRunCount; ++i) {
-        snowcrash::BlueprintParserOptions options = 0;
         snowcrash::Result result;
         snowcrash::Blueprint blueprint;
 
@@ -102,10 +134,32 @@ int main(int argc, const char *argv[])
     std::cout << "running snowcrash performance test...\n";
     
     double mean = 0, total = 0, stddev = 0;
-    int result = testfunc(inputStream.str(), total, mean, stddev);
+    snowcrash::ResetSignatureMemoStatistics();
+    size_t allocations = AllocationCount;
+    int result = testfunc(inputStream.str(), 0, total, mean, stddev);
+    allocations = AllocationCount - allocations;
+    snowcrash::SignatureMemoStatistics memo = snowcrash::GetSignatureMemoStatistics();
     
     std::cout << "parsing '" << inputFileName << "' " << TestRunCount << "-times (" << result << "):\n";
     std::cout << "total: " << total << "s mean: " << mean << " +/- " << stddev << "s\n";
+    std::cout << "signature memo per parse: " << memo.lookups / TestRunCount << " lookups, ";
+    std::cout << memo.hits / TestRunCount << " classifications saved\n";
+    std::cout << "heap allocations per parse: " << allocations / TestRunCount << "\n";
+    
+    double skipMean = 0, skipTotal = 0, skipStddev = 0;
+    testfunc(inputStream.str(), snowcrash::SkipSourceMapOption, skipTotal, skipMean, skipStddev);
+    
+    std::cout << "without annotation source maps: total: " << skipTotal << "s mean: " << skipMean << " +/- " << skipStddev << "s";
+    std::cout << " (" << (1.0 - skipTotal / total) * 100.0 << "% saved)\n";
+    
+    double validateMean = 0, validateTotal = 0, validateStddev = 0;
+    allocations = AllocationCount;
+    testfunc(inputStream.str(), snowcrash::ValidateOnlyOption, validateTotal, validateMean, validateStddev);
+    allocations = AllocationCount - allocations;
+    
+    std::cout << "validation only: total: " << validateTotal << "s mean: " << validateMean << " +/- " << validateStddev << "s";
+    std::cout << " (" << (1.0 - validateTotal / total) * 100.0 << "% saved), ";
+    std::cout << allocations / TestRunCount << " heap allocations per parse\n";
     
     // FIXME: Intstrumetns helper
     //::sleep(20);
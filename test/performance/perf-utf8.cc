@@ -0,0 +1,128 @@
+//
+//  perf-utf8.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <sys/time.h>
+#include "cmdline.h"
+#include "UTF8.h"
+
+using namespace snowcrash;
+
+static const int TestRunCount = 20;
+
+/** Minimal size of the benchmarked input (bytes) */
+static const size_t MinInputSize = 16 * 1024 * 1024;
+
+#define UTF8_CHAR_LEN( byte ) (( 0xE5000000 >> (( byte >> 3 ) & 0x1e )) & 3 ) + 1
+
+/** Characters counted by stepping lead bytes, as the source maps used to */
+static size_t CountStepping(const char* s, size_t len)
+{
+    size_t i = 0, j = 0;
+    while (i < len && s[i]) {
+        i += UTF8_CHAR_LEN(s[i]);
+        j++;
+    }
+    return j;
+}
+
+/** \return Current time in seconds */
+static double now()
+{
+    struct timeval tv;
+    if (::gettimeofday(&tv, NULL)) {
+        std::cerr << "fatal: gettimeofday failed";
+        exit(EXIT_FAILURE);
+    }
+
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ *  \brief  Count characters of input @TestRunCount -times
+ *  \return Throughput in MiB/s.
+ */
+static double testfunc(const std::string& input, UTF8CountKernel kernel, bool stepping, size_t& count)
+{
+    double start = now();
+    for (int i = 0; i < TestRunCount; ++i) {
+        if (stepping)
+            count = CountStepping(input.data(), input.length());
+        else
+            count = CountUTF8Characters(input.data(), input.length(), kernel);
+    }
+
+    return (input.length() * TestRunCount) / ((now() - start) * 1024 * 1024);
+}
+
+int main(int argc, const char *argv[])
+{
+    // Setup commandline Argument Parser
+    cmdline::parser argumentParser;
+    argumentParser.set_program_name("perf-utf8");
+    std::stringstream ss;
+    ss << "<input file>\n\n";
+    ss << "API Blueprint UTF-8 Character Counting Performance Test Tool\n";
+
+    argumentParser.footer(ss.str());
+    argumentParser.add("help", 'h', "display this help message");
+
+    argumentParser.parse_check(argc, argv);
+    if (argumentParser.rest().size() != 1) {
+        std::cerr << "one input file expected\n";
+        exit(EXIT_FAILURE);
+    }
+
+    // Read fixture file
+    std::ifstream inputFileStream;
+    std::string inputFileName = argumentParser.rest().front();
+    inputFileStream.open(inputFileName.c_str());
+    if (!inputFileStream.is_open()) {
+        std::cerr << "fatal: unable to open input file '" << inputFileName << "'\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::stringstream inputStream;
+    inputStream << inputFileStream.rdbuf();
+    inputFileStream.close();
+
+    // Replicate the fixture up to the benchmarked size, add some multi-byte text
+    std::string fixture = inputStream.str() + "\nPříliš žluťoučký kůň úpěl ďábelské ódy. 中文\n";
+    std::string input;
+    input.reserve(MinInputSize + fixture.length());
+    while (input.length() < MinInputSize)
+        input += fixture;
+
+    std::cout << "running snowcrash UTF-8 character counting performance test...\n";
+    std::cout << input.length() / 1024 << "KiB of '" << inputFileName << "', " << TestRunCount << "-times:\n";
+
+    size_t expected = 0;
+    double throughput = testfunc(input, ScalarUTF8CountKernel, true, expected);
+    std::cout << "lead byte stepping: " << throughput << " MiB/s\n";
+
+    const char* names[] = { "scalar", "sse2", "avx2" };
+    const UTF8CountKernel kernels[] = { ScalarUTF8CountKernel, SSE2UTF8CountKernel, AVX2UTF8CountKernel };
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!IsUTF8CountKernelSupported(kernels[k])) {
+            std::cout << names[k] << ": not supported\n";
+            continue;
+        }
+
+        size_t count = 0;
+        throughput = testfunc(input, kernels[k], false, count);
+        std::cout << names[k] << ": " << throughput << " MiB/s";
+        std::cout << ((kernels[k] == GetUTF8CountKernel()) ? " (selected)\n" : "\n");
+
+        if (count != expected) {
+            std::cerr << "fatal: " << names[k] << " character count differs\n";
+            exit(EXIT_FAILURE);
+        }
+    }
+}
@@ -30,3 +30,58 @@ TEST_CASE("blueprint/init", "Blueprint initializaton")
 }
 
 
+
+TEST_CASE("blueprint/shared-asset", "Copies of a payload share its assets")
+{
+    Payload model;
+    REQUIRE(model.body.empty());
+    REQUIRE(model.body == "");
+
+    model.body = "{ \"id\": 1 }\n";
+    model.schema = std::string("{}");
+
+    Payload payload = model;
+    REQUIRE(payload.body == "{ \"id\": 1 }\n");
+    REQUIRE(payload.body.sharedWith(model.body));
+    REQUIRE(payload.schema.sharedWith(model.schema));
+    REQUIRE(payload.body.str() == model.body.str());
+
+    // Assigning a payload's asset does not affect its copies
+    payload.body = "{}";
+    REQUIRE(!payload.body.sharedWith(model.body));
+    REQUIRE(payload.body == model.schema);
+    REQUIRE(payload.body != model.body);
+    REQUIRE(model.body.length() == 12);
+
+    payload.body.clear();
+    REQUIRE(payload.body.empty());
+    REQUIRE(!payload.body.sharedWith(Payload().body));
+}
+
+TEST_CASE("blueprint/shared-asset-string", "Assets are read and appended as strings")
+{
+    Payload model;
+    model.body = "{ \"id\": 1 }";
+
+    const std::string& body = model.body;
+    REQUIRE(body == "{ \"id\": 1 }");
+    REQUIRE(model.body.find("id") == 3);
+    REQUIRE(model.body.find('}') == 10);
+    REQUIRE(model.body.substr(2, 4) == "\"id\"");
+    REQUIRE(model.body[0] == '{');
+    REQUIRE(model.body.compare("{ \"id\": 1 }") == 0);
+    REQUIRE(std::string(model.body.begin(), model.body.end()) == body);
+    REQUIRE(std::string(model.body.data(), model.body.size()) == body);
+
+    // Appending does not affect the copies sharing the asset
+    Payload payload = model;
+    payload.body += "\n";
+    REQUIRE(payload.body == "{ \"id\": 1 }\n");
+    REQUIRE(model.body == "{ \"id\": 1 }");
+    REQUIRE(!payload.body.sharedWith(model.body));
+
+    SharedAsset empty;
+    REQUIRE(empty.str() == EmptyAsset);
+    empty.append("");
+    REQUIRE(empty.empty());
+}
@@ -0,0 +1,168 @@
+//
+//  test-BlueprintArena.cc
+//  snowcrash
+//
+//  Created by agent on 10/17/26.
+//
+
+#include <sstream>
+#include "catch.hpp"
+#include "BlueprintArena.h"
+#include "SerializeJSON.h"
+
+using namespace snowcrash;
+
+/** \return True if a slice points into a source */
+static bool IsSourceSlice(const StringSlice& slice, const char* source, size_t length)
+{
+    return slice.data >= source && slice.data + slice.length <= source + length;
+}
+
+TEST_CASE("arena/allocate", "Arena hands out aligned memory out of chunks")
+{
+    Arena arena(1024);
+    REQUIRE(arena.chunks() == 0);
+
+    char* byte = static_cast<char*>(arena.allocate(1, 1));
+    void* aligned = arena.allocate(16);
+    REQUIRE(reinterpret_cast<size_t>(aligned) % Arena::Alignment == 0);
+    REQUIRE(static_cast<char*>(aligned) > byte);
+    REQUIRE(arena.chunks() == 1);
+    REQUIRE(arena.size() == 17);
+
+    // Large request not fitting the chunk gets a chunk of its own
+    arena.allocate(1020);
+    REQUIRE(arena.chunks() == 2);
+    REQUIRE(arena.capacity() == 1024 + 1020);
+
+    // The current chunk is still used
+    arena.allocate(8);
+    REQUIRE(arena.chunks() == 2);
+
+    arena.clear();
+    REQUIRE(arena.chunks() == 0);
+    REQUIRE(arena.size() == 0);
+}
+
+TEST_CASE("arena/round-trip", "Blueprint is held by an arena and materialized back")
+{
+    SourceData source = "FORMAT: 1A\n\n# API\nDescription\n\n## Resource [/resource]\n"
+                        "+ Model (text/plain)\n\n        Hello\n\n### Retrieve [GET]\n"
+                        "+ Response 200\n\n    [Resource][]\n";
+
+    Blueprint blueprint;
+    blueprint.metadata.push_back(std::make_pair("FORMAT", "1A"));
+    blueprint.name = "API";
+    blueprint.description = "<p>Description</p>\n";
+
+    ResourceGroup group;
+    Resource resource;
+    resource.uriTemplate = "/resource";
+    resource.name = "Resource";
+    resource.model.name = "Resource";
+    resource.model.headers.push_back(std::make_pair("Content-Type", "text/plain"));
+    resource.model.body = "Hello\n";
+
+    Parameter parameter;
+    parameter.name = "id";
+    parameter.use = RequiredParameterUse;
+    parameter.values.push_back("1");
+    parameter.values.push_back("2");
+    resource.parameters.push_back(parameter);
+
+    Action action;
+    action.method = "GET";
+    action.name = "Retrieve";
+
+    TransactionExample example;
+    Response response;
+    response.name = "200";
+    response.reference = "Resource";
+    response.body = resource.model.body;
+    example.responses.push_back(response);
+    action.examples.push_back(example);
+    resource.actions.push_back(action);
+    group.resources.push_back(resource);
+    blueprint.resourceGroups.push_back(group);
+
+    BlueprintArena arena(blueprint, source);
+    const ArenaBlueprint& ast = arena.blueprint();
+
+    REQUIRE(ast.metadata.size() == 1);
+    REQUIRE(ast.metadata[0].first.str() == "FORMAT");
+    REQUIRE(ast.name.str() == "API");
+    REQUIRE(ast.resourceGroups.size() == 1);
+    REQUIRE(ast.resourceGroups[0].name.empty());
+    REQUIRE(ast.resourceGroups[0].resources.size() == 1);
+
+    const ArenaResource& arenaResource = ast.resourceGroups[0].resources[0];
+    REQUIRE(arenaResource.uriTemplate.str() == "/resource");
+    REQUIRE(arenaResource.parameters[0].use == RequiredParameterUse);
+    REQUIRE(arenaResource.parameters[0].values.size() == 2);
+    REQUIRE(arenaResource.parameters[0].values[1].str() == "2");
+    REQUIRE(arenaResource.actions[0].examples[0].responses[0].reference.str() == "Resource");
+
+    // Strings found in the source are not copied, the retained source outlives the caller's
+    const char* retained = ast.metadata[0].first.data;
+    REQUIRE(retained != source.data());
+    REQUIRE(SourceData(retained, source.length()) == source);
+    REQUIRE(IsSourceSlice(ast.name, retained, source.length()));
+    REQUIRE(IsSourceSlice(arenaResource.model.headers[0].second, retained, source.length()));
+    REQUIRE(!IsSourceSlice(ast.description, retained, source.length()));
+    REQUIRE(arena.slicedLength() > 0);
+
+    // Materialized blueprint equals the original
+    Blueprint materialized;
+    arena.materialize(materialized);
+
+    std::stringstream expected, actual;
+    SerializeJSON(blueprint, expected);
+    SerializeJSON(materialized, actual);
+    REQUIRE(actual.str() == expected.str());
+
+    // Without a source all strings are copied
+    arena.assign(blueprint, SourceData());
+    REQUIRE(arena.slicedLength() == 0);
+    REQUIRE(arena.blueprint().resourceGroups[0].resources[0].model.body.str() == "Hello\n");
+
+    arena.clear();
+    REQUIRE(arena.blueprint().resourceGroups.empty());
+    REQUIRE(arena.memoryFootprint() == 0);
+}
+
+TEST_CASE("arena/intern", "Strings not found in the source are interned in the arena")
+{
+    Blueprint blueprint;
+    ResourceGroup group;
+
+    for (int i = 0; i < 2; ++i) {
+        Resource resource;
+        resource.uriTemplate = (i == 0) ? "/a" : "/b";
+        resource.model.headers.push_back(std::make_pair("Content-Type", "application/json"));
+        resource.model.body = "{ \"id\": 42 }\n";
+        group.resources.push_back(resource);
+    }
+
+    blueprint.resourceGroups.push_back(group);
+
+    BlueprintArena arena(blueprint, SourceData());
+    const ArenaResource& first = arena.blueprint().resourceGroups[0].resources[0];
+    const ArenaResource& second = arena.blueprint().resourceGroups[0].resources[1];
+
+    // Equal strings share one copy
+    REQUIRE(first.model.headers[0].first.data == second.model.headers[0].first.data);
+    REQUIRE(first.model.headers[0].second.data == second.model.headers[0].second.data);
+    REQUIRE(first.model.body.data == second.model.body.data);
+    REQUIRE(first.uriTemplate.data != second.uriTemplate.data);
+    REQUIRE(second.model.body.str() == "{ \"id\": 42 }\n");
+
+    // "/a", "/b", "Content-Type", "application/json" and the body
+    REQUIRE(arena.internedCount() == 5);
+
+    Blueprint materialized;
+    arena.materialize(materialized);
+    REQUIRE(materialized.resourceGroups[0].resources[1].model.headers[0].first == "Content-Type");
+
+    arena.clear();
+    REQUIRE(arena.internedCount() == 0);
+}
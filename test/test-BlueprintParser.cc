@@ -606,3 +606,440 @@ TEST_CASE("Fail to parse paragraph without final newline", "[blueprint][issue][#
     REQUIRE(blueprint.resourceGroups.empty());
 }
 
+
+TEST_CASE("bpparser/skip-source-map", "Skip source map option annotates without locations")
+{
+    // Blueprint in question:
+    //R"(
+    //# GET /resource
+    //");
+    
+    SourceData source = "# GET /resource\n";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /resource", 1, MakeSourceDataBlock(0, 16)));
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(source, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 1); // no response
+    REQUIRE(!result.warnings[0].location.empty());
+    
+    Result skippedResult;
+    Blueprint skippedBlueprint;
+    BlueprintParser::Parse(source, markdown, SkipSourceMapOption, skippedResult, skippedBlueprint);
+    REQUIRE(skippedResult.error.code == Error::OK);
+    REQUIRE(skippedResult.warnings.size() == 1);
+    REQUIRE(skippedResult.warnings[0].code == result.warnings[0].code);
+    REQUIRE(skippedResult.warnings[0].message == result.warnings[0].message);
+    REQUIRE(skippedResult.warnings[0].location.empty());
+    
+    REQUIRE(skippedBlueprint.resourceGroups.size() == blueprint.resourceGroups.size());
+}
+
+/** Collect streamed warnings */
+static void CollectWarning(const Warning& warning, void* data)
+{
+    static_cast<Warnings*>(data)->push_back(warning);
+}
+
+TEST_CASE("bpparser/warning-callback", "Warnings are streamed to a callback as found")
+{
+    // Blueprint in question:
+    //R"(
+    //# GET /a
+    //# GET /b
+    //");
+    
+    SourceData source = "# GET /a\n# GET /b\n";
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /a", 1, MakeSourceDataBlock(0, 9)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /b", 1, MakeSourceDataBlock(9, 9)));
+    
+    Warnings streamed;
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(source, markdown, 0, result, blueprint, CollectWarning, &streamed);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2); // no responses
+    REQUIRE(streamed.size() == result.warnings.size());
+    
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        REQUIRE(streamed[i].code == result.warnings[i].code);
+        REQUIRE(streamed[i].message == result.warnings[i].message);
+        REQUIRE(streamed[i].location.size() == result.warnings[i].location.size());
+    }
+    
+    REQUIRE(result.warnings[0].location[0].location < result.warnings[1].location[0].location);
+}
+
+/** Require parsing resource groups in parallel to match the serial parser */
+static void RequireParallelParse(const MarkdownBlock::Stack& markdown,
+                                 Result& result,
+                                 Blueprint& blueprint,
+                                 const ParserBudget& budget = ParserBudget())
+{
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, budget);
+    
+    Result parallelResult;
+    Blueprint parallelBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, ParallelResourceGroupsOption, parallelResult, parallelBlueprint,
+                           NULL, NULL, budget);
+    
+    REQUIRE(parallelResult.error.code == result.error.code);
+    REQUIRE(parallelResult.error.message == result.error.message);
+    REQUIRE(parallelResult.error.location.size() == result.error.location.size());
+    for (size_t i = 0; i < result.error.location.size(); ++i)
+        REQUIRE(parallelResult.error.location[i].location == result.error.location[i].location);
+    
+    REQUIRE(parallelResult.warnings.size() == result.warnings.size());
+    for (size_t i = 0; i < result.warnings.size(); ++i) {
+        REQUIRE(parallelResult.warnings[i].code == result.warnings[i].code);
+        REQUIRE(parallelResult.warnings[i].message == result.warnings[i].message);
+    }
+    
+    REQUIRE(parallelBlueprint.resourceGroups.size() == blueprint.resourceGroups.size());
+    for (size_t i = 0; i < blueprint.resourceGroups.size(); ++i) {
+        const ResourceGroup& group = blueprint.resourceGroups[i];
+        const ResourceGroup& parallelGroup = parallelBlueprint.resourceGroups[i];
+        REQUIRE(parallelGroup.name == group.name);
+        REQUIRE(parallelGroup.resources.size() == group.resources.size());
+        
+        for (size_t j = 0; j < group.resources.size(); ++j) {
+            const Resource& resource = group.resources[j];
+            const Resource& parallelResource = parallelGroup.resources[j];
+            REQUIRE(parallelResource.uriTemplate == resource.uriTemplate);
+            REQUIRE(parallelResource.model.body == resource.model.body);
+            REQUIRE(parallelResource.actions.size() == resource.actions.size());
+            
+            for (size_t k = 0; k < resource.actions.size(); ++k) {
+                REQUIRE(parallelResource.actions[k].examples.size() == resource.actions[k].examples.size());
+                if (!resource.actions[k].examples.empty() && !resource.actions[k].examples[0].responses.empty())
+                    REQUIRE(parallelResource.actions[k].examples[0].responses[0].body == resource.actions[k].examples[0].responses[0].body);
+            }
+        }
+    }
+}
+
+TEST_CASE("bpparser/parallel-resource-groups-budget", "Parse resource groups in parallel within a budget as the serial parser")
+{
+    // Blueprint in question:
+    //R"(
+    //# Group A
+    //# GET /a
+    //# GET /b
+    //# Group B
+    //# GET /c
+    //# GET /d
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /a", 1, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /b", 1, MakeSourceDataBlock(2, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group B", 1, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /c", 1, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /d", 1, MakeSourceDataBlock(5, 1)));
+    
+    // Every action lacks a response
+    ParserBudget budget;
+    budget.maxWarnings = 2;
+    
+    Result result;
+    Blueprint blueprint;
+    RequireParallelParse(markdown, result, blueprint, budget);
+    REQUIRE(result.error.code == BudgetError);
+    
+    budget.maxWarnings = 0;
+    budget.maxASTBytes = 1;
+    
+    Result astResult;
+    Blueprint astBlueprint;
+    RequireParallelParse(markdown, astResult, astBlueprint, budget);
+}
+
+TEST_CASE("bpparser/parallel-resource-groups", "Parse resource groups in parallel as the serial parser")
+{
+    // Blueprint in question:
+    //R"(
+    //# /0
+    //# Group A
+    // <see CanonicalResourceFixture()>
+    //# Group B
+    //# /b
+    //## GET
+    //+ Response 200
+    //    [My Resource][]
+    //
+    //# Group C
+    //# /c
+    //# /b
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "/0", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group A", 1, MakeSourceDataBlock(1, 1)));
+    
+    MarkdownBlock::Stack resource = CanonicalResourceFixture();
+    markdown.insert(markdown.end(), resource.begin(), resource.end());
+    
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group B", 1, MakeSourceDataBlock(10, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "/b", 1, MakeSourceDataBlock(11, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(12, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(13, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(14, 1)));
+    
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group C", 1, MakeSourceDataBlock(15, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "/c", 1, MakeSourceDataBlock(16, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "/b", 1, MakeSourceDataBlock(17, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    RequireParallelParse(markdown, result, blueprint);
+    
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(blueprint.resourceGroups.size() == 4);
+    REQUIRE(blueprint.resourceGroups[2].resources.size() == 1);
+    REQUIRE(blueprint.resourceGroups[2].resources[0].actions[0].examples[0].responses[0].body == "X.O.");
+    REQUIRE(!result.warnings.empty());
+    REQUIRE(result.warnings.back().code == DuplicateWarning);
+    
+    // Redefined model
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "Group D", 1, MakeSourceDataBlock(18, 1)));
+    markdown.insert(markdown.end(), resource.begin(), resource.end());
+    
+    Result errorResult;
+    Blueprint errorBlueprint;
+    RequireParallelParse(markdown, errorResult, errorBlueprint);
+    REQUIRE(errorResult.error.code != Error::OK);
+}
+
+TEST_CASE("bpparser/forward-model-reference", "Refer a model defined later in the blueprint")
+{
+    // Blueprint in question:
+    //R"(
+    //# GET /b
+    //+ Response 200
+    //    [My Resource][]
+    //
+    // <see CanonicalResourceFixture()>
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /b", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
+    
+    MarkdownBlock::Stack resource = CanonicalResourceFixture();
+    markdown.insert(markdown.end(), resource.begin(), resource.end());
+    
+    Result result;
+    Blueprint blueprint;
+    Warnings streamed;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, CollectWarning, &streamed);
+    
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(streamed.size() == result.warnings.size());
+    REQUIRE(blueprint.resourceGroups.size() == 1);
+    REQUIRE(blueprint.resourceGroups[0].resources.size() == 2);
+    
+    const Response& response = blueprint.resourceGroups[0].resources[0].actions[0].examples[0].responses[0];
+    REQUIRE(response.name == "200");
+    REQUIRE(response.reference == "My Resource");
+    REQUIRE(response.body == "X.O.");
+    REQUIRE(response.body.sharedWith(blueprint.resourceGroups[0].resources[1].model.body));
+    REQUIRE(response.headers.size() == 1);
+    REQUIRE(response.headers[0].first == "Content-Type");
+    REQUIRE(response.headers[0].second == "text/plain");
+    
+    // Undefined model
+    markdown[3].content = "Response 200\n  [Undefined][]";
+    
+    Result errorResult;
+    Blueprint errorBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, errorResult, errorBlueprint);
+    REQUIRE(errorResult.error.code == SymbolError);
+    REQUIRE(errorResult.error.message == "undefined symbol 'Undefined'");
+    
+    // Stops at the reference, the model after it is not parsed
+    REQUIRE(errorResult.error.location.size() == 1);
+    REQUIRE(errorResult.error.location[0].location == 1);
+    REQUIRE(errorBlueprint.resourceGroups.empty());
+}
+
+TEST_CASE("bpparser/validate", "Validate reporting the same diagnostics as parsing")
+{
+    MarkdownBlock::Stack markdown = CanonicalBlueprintFixture();
+    
+    ParserBudget astBudget;
+    astBudget.maxASTBytes = 4;
+    
+    const ParserBudget budgets[] = { ParserBudget(), astBudget };
+    for (size_t i = 0; i < sizeof(budgets) / sizeof(budgets[0]); ++i) {
+        
+        Result result;
+        Blueprint blueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, budgets[i]);
+        
+        Result validateResult;
+        Blueprint validateBlueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, ValidateOnlyOption, validateResult, validateBlueprint, NULL, NULL, budgets[i]);
+        
+        REQUIRE(validateResult.error.code == result.error.code);
+        REQUIRE(validateResult.error.message == result.error.message);
+        REQUIRE(validateResult.error.location.size() == result.error.location.size());
+        for (size_t l = 0; l < result.error.location.size(); ++l) {
+            REQUIRE(validateResult.error.location[l].location == result.error.location[l].location);
+            REQUIRE(validateResult.error.location[l].length == result.error.location[l].length);
+        }
+        
+        REQUIRE(validateResult.warnings.size() == result.warnings.size());
+        for (size_t w = 0; w < result.warnings.size(); ++w) {
+            REQUIRE(validateResult.warnings[w].code == result.warnings[w].code);
+            REQUIRE(validateResult.warnings[w].message == result.warnings[w].message);
+        }
+        
+        REQUIRE(validateBlueprint.description.empty());
+    }
+    
+    // The description and the assets are spent from the budget
+    Result exceededResult;
+    Blueprint exceededBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, ValidateOnlyOption, exceededResult, exceededBlueprint, NULL, NULL, astBudget);
+    REQUIRE(exceededResult.error.code == BudgetError);
+}
+
+TEST_CASE("bpparser/validate-model-reference-budget", "Validate spending model references from the budget as parsing")
+{
+    // Blueprint in question:
+    //R"(
+    //# GET /a
+    //+ Response 200
+    //    [My Resource][]
+    //
+    //# My Resource [/r]
+    //+ Model (text/plain)
+    //
+    //    ABCDEFGHIJ
+    //
+    //    + Body
+    //
+    //            X.O.
+    //
+    //## GET
+    //+ Response 200
+    //    [My Resource][]
+    //");
+
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /a", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
+
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "My Resource [/r]", 1, MakeSourceDataBlock(3, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Model (text/plain)", 0, MakeSourceDataBlock(4, 1)));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "ABCDEFGHIJ", 0, MakeSourceDataBlock(10, 10)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ParagraphBlockType, "Body", 0, MakeSourceDataBlock(5, 1)));
+    markdown.push_back(MarkdownBlock(CodeBlockType, "X.O.", 0, MakeSourceDataBlock(6, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(7, 1)));
+
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET", 2, MakeSourceDataBlock(8, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(9, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(9, 1)));
+
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(blueprint.resourceGroups.size() == 1);
+    REQUIRE(blueprint.resourceGroups[0].resources.size() == 2);
+    REQUIRE(blueprint.resourceGroups[0].resources[1].model.description == "ABCDEFGHIJ");
+
+    // Both references spend the model description, wherever the limit falls
+    bool exceeded = false;
+    for (size_t maxASTBytes = 1; maxASTBytes <= 64; ++maxASTBytes) {
+
+        ParserBudget budget;
+        budget.maxASTBytes = maxASTBytes;
+
+        Result budgetResult;
+        Blueprint budgetBlueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, 0, budgetResult, budgetBlueprint, NULL, NULL, budget);
+
+        Result validateResult;
+        Blueprint validateBlueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, ValidateOnlyOption, validateResult, validateBlueprint, NULL, NULL, budget);
+
+        REQUIRE(validateResult.error.code == budgetResult.error.code);
+        REQUIRE(validateResult.error.message == budgetResult.error.message);
+        REQUIRE(validateResult.error.location.size() == budgetResult.error.location.size());
+        for (size_t l = 0; l < budgetResult.error.location.size(); ++l)
+            REQUIRE(validateResult.error.location[l].location == budgetResult.error.location[l].location);
+
+        REQUIRE(validateResult.warnings.size() == budgetResult.warnings.size());
+
+        if (budgetResult.error.code == BudgetError)
+            exceeded = true;
+    }
+
+    REQUIRE(exceeded);
+}
+
+TEST_CASE("bpparser/budget", "Stop parsing when exceeding the parser budget")
+{
+    MarkdownBlock::Stack markdown = CanonicalResourceFixture();
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /a", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /b", 1, MakeSourceDataBlock(1, 1)));
+    
+    ParserBudget budget;
+    budget.maxBlocks = markdown.size();
+    budget.maxNesting = 4;
+    budget.maxWarnings = 2;
+    budget.maxTime = 60000;
+    budget.maxASTBytes = 1024;
+    
+    Result result;
+    Blueprint blueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, budget);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(result.warnings.size() == 2);
+    
+    ParserBudget blocksBudget;
+    blocksBudget.maxBlocks = markdown.size() - 1;
+    
+    ParserBudget nestingBudget;
+    nestingBudget.maxNesting = 1;
+    
+    ParserBudget warningsBudget;
+    warningsBudget.maxWarnings = 1;
+    
+    ParserBudget astBudget;
+    astBudget.maxASTBytes = 4;
+    
+    const ParserBudget exceeded[] = { blocksBudget, nestingBudget, warningsBudget, astBudget };
+    for (size_t i = 0; i < sizeof(exceeded) / sizeof(exceeded[0]); ++i) {
+        
+        Result exceededResult;
+        Blueprint exceededBlueprint;
+        BlueprintParser::Parse(SourceDataFixture, markdown, 0, exceededResult, exceededBlueprint, NULL, NULL, exceeded[i]);
+        REQUIRE(exceededResult.error.code == BudgetError);
+        REQUIRE(exceededResult.error.message.find("exceeded the parser budget") == 0);
+    }
+}
@@ -8,6 +8,7 @@
 
 #include "catch.hpp"
 #include "MarkdownBlock.h"
+#include "BlockUtility.h"
 
 using namespace snowcrash;
 
@@ -34,3 +35,111 @@ TEST_CASE("mdblock/init-param", "MD block construction with parameters")
     REQUIRE(block.data == static_cast<MarkdownBlock::Data>(0));
     REQUIRE(block.sourceMap.size() == 0);
 }
+
+TEST_CASE("mdblock/swap", "MD block swap")
+{
+    SourceDataBlock sourceMap;
+    SourceDataRange range = {2, 5};
+    sourceMap.push_back(range);
+    
+    MarkdownBlock block(ParagraphBlockType, "lorem ipsum dolor sit amet", 1, sourceMap);
+    const char* buffer = block.content.data();
+    
+    MarkdownBlock other;
+    other.swap(block);
+    REQUIRE(other.type == ParagraphBlockType);
+    REQUIRE(other.content == "lorem ipsum dolor sit amet");
+    REQUIRE(other.data == 1);
+    REQUIRE(other.sourceMap.size() == 1);
+    REQUIRE(other.sourceMap[0].location == 2);
+    
+    REQUIRE(block.type == UndefinedBlockType);
+    REQUIRE(block.content.empty());
+    REQUIRE(block.sourceMap.empty());
+    
+    // Content handed over, not copied
+    REQUIRE(other.content.data() == buffer);
+}
+
+TEST_CASE("mdblock/content", "MD block content views a shared buffer")
+{
+    MarkdownBlock::Content::Buffer buffer = std::make_shared<const std::string>("# Title\nlorem\nipsum\n");
+    MarkdownBlock::Content content(buffer, 8, 12);
+    REQUIRE(content == "lorem\nipsum\n");
+    REQUIRE(content.length() == 12);
+    REQUIRE(content.find('\n') == 5);
+    REQUIRE(content.find('x') == std::string::npos);
+    
+    // Parts and copies share the buffer
+    MarkdownBlock::Content line = GetFirstLine(content);
+    REQUIRE(line == "lorem");
+    REQUIRE(line.data() == content.data());
+    REQUIRE(line.sharedWith(buffer));
+    REQUIRE(content.substr(6) == "ipsum\n");
+    REQUIRE(content.substr(20).empty());
+    
+    MarkdownBlock block(ParagraphBlockType, content);
+    REQUIRE(block.content.data() == buffer->data() + 8);
+    
+    // Materialized on demand
+    std::string text = block.content;
+    REQUIRE(text == "lorem\nipsum\n");
+    
+    block.content = "dolor";
+    REQUIRE(block.content == "dolor");
+    REQUIRE(!block.content.sharedWith(buffer));
+    
+    MarkdownBlock::Content empty(buffer, 3, 0);
+    REQUIRE(empty.empty());
+    REQUIRE(!empty.sharedWith(buffer));
+}
+
+TEST_CASE("mdblock/closing-blocks", "Skip to closing blocks matched in advance")
+{
+    // + A
+    //     > + B
+    // + C
+    MarkdownBlockType types[] = {
+        ListBlockBeginType,
+        ListItemBlockBeginType,
+        QuoteBlockBeginType,
+        ListBlockBeginType,
+        ListItemBlockBeginType,
+        ListItemBlockEndType,
+        ListBlockEndType,
+        QuoteBlockEndType,
+        ListItemBlockEndType,
+        ListItemBlockBeginType,
+        ListItemBlockEndType,
+        ListBlockEndType,
+        ListItemBlockBeginType  // unmatched
+    };
+    
+    MarkdownBlock::Stack scanned;
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i)
+        scanned.push_back(MarkdownBlock(types[i]));
+    
+    MarkdownBlock::Stack matched(scanned);
+    MatchClosingBlocks(matched);
+    REQUIRE(matched[0].closingOffset == 11);
+    REQUIRE(matched[2].closingOffset == 5);
+    REQUIRE(matched[12].closingOffset == 0);
+    
+    MarkdownBlockType pairs[][2] = {
+        { ListBlockBeginType, ListBlockEndType },
+        { ListItemBlockBeginType, ListItemBlockEndType },
+        { QuoteBlockBeginType, QuoteBlockEndType },
+        { ListBlockBeginType, ListItemBlockEndType }
+    };
+    
+    // Same results as scanning, within any bounds
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); ++p) {
+        for (size_t i = 0; i < scanned.size(); ++i) {
+            for (size_t e = i + 1; e <= scanned.size(); ++e) {
+                BlockIterator scannedIt = SkipToClosingBlock(scanned.begin() + i, scanned.begin() + e, pairs[p][0], pairs[p][1]);
+                BlockIterator matchedIt = SkipToClosingBlock(matched.begin() + i, matched.begin() + e, pairs[p][0], pairs[p][1]);
+                REQUIRE(scannedIt - scanned.begin() == matchedIt - matched.begin());
+            }
+        }
+    }
+}
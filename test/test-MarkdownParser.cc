@@ -74,6 +74,29 @@ paragraph\n\
     REQUIRE(sourceData == "    code\n");
 }
 
+TEST_CASE("block contents view the text buffer of the parse", "[markdown]")
+{
+    MarkdownParser parser;
+    Result result;
+    MarkdownBlock::Stack markdown;
+    
+    parser.parse("# header\nparagraph\n", result, markdown);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(markdown.size() == 2);
+    REQUIRE(markdown[0].content == "header");
+    REQUIRE(markdown[1].content == "paragraph");
+    
+    // The contents of a parse are laid out in one buffer
+    REQUIRE(markdown[1].content.data() == markdown[0].content.data() + markdown[0].content.length());
+    
+    // A block kept from the previous parse keeps its text
+    MarkdownBlock header = markdown[0];
+    parser.parse("# other\n", result, markdown);
+    REQUIRE(markdown.size() == 1);
+    REQUIRE(markdown[0].content == "other");
+    REQUIRE(header.content == "header");
+}
+
 TEST_CASE("parsing Markdown with HTML into AST", "[markdown]")
 {
     MarkdownParser parser;
@@ -391,6 +414,25 @@ TEST_CASE("parse nested inline list testing source maps", "[markdown]")
     REQUIRE(markdown[11].sourceMap[0].length == 35);
 }
 
+TEST_CASE("begin blocks are matched with their closing blocks as rendered", "[markdown]")
+{
+    MarkdownParser parser;
+    Result result;
+    MarkdownBlock::Stack markdown;
+    
+    parser.parse("+ A\n\n    > + B\n    >     + C\n\n+ D\n", result, markdown);
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(!markdown.empty());
+    REQUIRE(markdown[0].type == ListBlockBeginType);
+    REQUIRE(markdown[0].closingOffset == static_cast<int>(markdown.size() - 1));
+    
+    // Same as matched after the parse
+    MarkdownBlock::Stack matched = markdown;
+    MatchClosingBlocks(matched);
+    for (size_t i = 0; i < markdown.size(); ++i)
+        REQUIRE(markdown[i].closingOffset == matched[i].closingOffset);
+}
+
 TEST_CASE("parsing complex nested Markdown into AST", "[markdown]")
 {
     MarkdownParser parser;
@@ -854,3 +896,60 @@ TEST_CASE("Source map crash - assertion", "[markdown][issue][#62][sourcemap]")
     
     REQUIRE(markdown.size() == 16);
 }
+
+TEST_CASE("Source character index maps as the source", "[markdown][sourcemap]")
+{
+    // Multi-byte characters over several index checkpoints
+    SourceData source;
+    for (size_t i = 0; i < 100; ++i)
+        source += "Příliš žluťoučký kůň\n中文\n";
+
+    SourceCharacterIndex index(source);
+    for (size_t location = 0; location <= source.length(); location += 7) {
+        SourceDataRange range = { location, static_cast<size_t>((location + 5 < source.length()) ? 5 : 0) };
+        SourceCharactersRange expected = MapSourceDataRange(range, source);
+        SourceCharactersRange indexed = index.mapRange(range);
+
+        REQUIRE(indexed.location == expected.location);
+        REQUIRE(indexed.length == expected.length);
+    }
+
+    {
+        SourceCharacterIndex::Scope scope(index);
+        REQUIRE(SourceCharacterIndex::Active(source) == &index);
+        REQUIRE(SourceCharacterIndex::Active(SourceData(source)) == NULL);
+    }
+
+    REQUIRE(SourceCharacterIndex::Active(source) == NULL);
+}
+
+TEST_CASE("Source character index line and column", "[markdown][sourcemap]")
+{
+    SourceData source = "# API\n\nČeský text\nčára\n";
+    source += '\0';
+    source += "ignored\n";
+
+    SourceCharacterIndex index(source);
+    size_t line, column;
+
+    index.lineColumn(0, line, column);
+    REQUIRE(line == 1);
+    REQUIRE(column == 1);
+
+    index.lineColumn(6, line, column);
+    REQUIRE(line == 2);
+    REQUIRE(column == 1);
+
+    // "čára" starts at 18th character
+    SourceDataRange range = { source.find("čára"), 2 };
+    SourceCharactersRange characterRange = index.mapRange(range);
+    REQUIRE(characterRange.location == 18);
+    REQUIRE(characterRange.length == 1);
+
+    index.lineColumn(characterRange.location + 1, line, column);
+    REQUIRE(line == 4);
+    REQUIRE(column == 2);
+
+    // Characters past NUL are not counted
+    REQUIRE(index.characterLocation(source.length()) == 23);
+}
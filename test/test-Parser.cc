@@ -83,6 +83,153 @@ Resource **description**\n\
     REQUIRE(response.body == "Text\n\n{ ... }\n");
 }
 
+static void RequireSameParameters(const Collection<Parameter>::type& lhs, const Collection<Parameter>::type& rhs)
+{
+    REQUIRE(lhs.size() == rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        REQUIRE(lhs[i].name == rhs[i].name);
+        REQUIRE(lhs[i].description == rhs[i].description);
+        REQUIRE(lhs[i].type == rhs[i].type);
+        REQUIRE(lhs[i].use == rhs[i].use);
+        REQUIRE(lhs[i].defaultValue == rhs[i].defaultValue);
+        REQUIRE(lhs[i].exampleValue == rhs[i].exampleValue);
+        REQUIRE(lhs[i].values == rhs[i].values);
+    }
+}
+
+static void RequireSamePayload(const Payload& lhs, const Payload& rhs)
+{
+    REQUIRE(lhs.name == rhs.name);
+    REQUIRE(lhs.description == rhs.description);
+    RequireSameParameters(lhs.parameters, rhs.parameters);
+    REQUIRE(lhs.headers == rhs.headers);
+    REQUIRE(lhs.body == rhs.body);
+    REQUIRE(lhs.schema == rhs.schema);
+    REQUIRE(lhs.reference == rhs.reference);
+}
+
+static void RequireSamePayloads(const Collection<Payload>::type& lhs, const Collection<Payload>::type& rhs)
+{
+    REQUIRE(lhs.size() == rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i)
+        RequireSamePayload(lhs[i], rhs[i]);
+}
+
+// Compares two blueprints field by field
+static void RequireSameBlueprint(const Blueprint& lhs, const Blueprint& rhs)
+{
+    REQUIRE(lhs.metadata == rhs.metadata);
+    REQUIRE(lhs.name == rhs.name);
+    REQUIRE(lhs.description == rhs.description);
+    REQUIRE(lhs.resourceGroups.size() == rhs.resourceGroups.size());
+    
+    for (size_t g = 0; g < lhs.resourceGroups.size(); ++g) {
+        const ResourceGroup& lhsGroup = lhs.resourceGroups[g];
+        const ResourceGroup& rhsGroup = rhs.resourceGroups[g];
+        REQUIRE(lhsGroup.name == rhsGroup.name);
+        REQUIRE(lhsGroup.description == rhsGroup.description);
+        REQUIRE(lhsGroup.resources.size() == rhsGroup.resources.size());
+        
+        for (size_t r = 0; r < lhsGroup.resources.size(); ++r) {
+            const Resource& lhsResource = lhsGroup.resources[r];
+            const Resource& rhsResource = rhsGroup.resources[r];
+            REQUIRE(lhsResource.uriTemplate == rhsResource.uriTemplate);
+            REQUIRE(lhsResource.name == rhsResource.name);
+            REQUIRE(lhsResource.description == rhsResource.description);
+            RequireSamePayload(lhsResource.model, rhsResource.model);
+            RequireSameParameters(lhsResource.parameters, rhsResource.parameters);
+            REQUIRE(lhsResource.headers == rhsResource.headers);
+            REQUIRE(lhsResource.actions.size() == rhsResource.actions.size());
+            
+            for (size_t a = 0; a < lhsResource.actions.size(); ++a) {
+                const Action& lhsAction = lhsResource.actions[a];
+                const Action& rhsAction = rhsResource.actions[a];
+                REQUIRE(lhsAction.method == rhsAction.method);
+                REQUIRE(lhsAction.name == rhsAction.name);
+                REQUIRE(lhsAction.description == rhsAction.description);
+                RequireSameParameters(lhsAction.parameters, rhsAction.parameters);
+                REQUIRE(lhsAction.headers == rhsAction.headers);
+                REQUIRE(lhsAction.examples.size() == rhsAction.examples.size());
+                
+                for (size_t e = 0; e < lhsAction.examples.size(); ++e) {
+                    const TransactionExample& lhsExample = lhsAction.examples[e];
+                    const TransactionExample& rhsExample = rhsAction.examples[e];
+                    REQUIRE(lhsExample.name == rhsExample.name);
+                    REQUIRE(lhsExample.description == rhsExample.description);
+                    RequireSamePayloads(lhsExample.requests, rhsExample.requests);
+                    RequireSamePayloads(lhsExample.responses, rhsExample.responses);
+                }
+            }
+        }
+    }
+}
+
+static void RequireSameResult(const Result& lhs, const Result& rhs)
+{
+    REQUIRE(lhs.error.code == rhs.error.code);
+    REQUIRE(lhs.error.message == rhs.error.message);
+    REQUIRE(lhs.warnings.size() == rhs.warnings.size());
+    for (size_t i = 0; i < lhs.warnings.size(); ++i) {
+        REQUIRE(lhs.warnings[i].code == rhs.warnings[i].code);
+        REQUIRE(lhs.warnings[i].message == rhs.warnings[i].message);
+        REQUIRE(lhs.warnings[i].location.size() == rhs.warnings[i].location.size());
+    }
+}
+
+TEST_CASE("Parse blueprints reusing parser context", "[parser]")
+{
+    const std::string blueprintSource = \
+"FORMAT: X-1A\n\
+\n\
+# API\n\
+Description\n\
+\n\
+# Group Resources\n\
+\n\
+# My Resource [/resource/{id}]\n\
++ Parameters\n\
+    + id (required, number, `1`) ... Identifier\n\
+\n\
++ Model (text/plain)\n\
+\n\
+        Model\n\
+\n\
+## Retrieve [GET]\n\
++ Request\n\
+    + Headers\n\
+\n\
+            Accept: text/plain\n\
+\n\
++ Response 200\n\
+\n\
+    [My Resource][]\n\
+\n\
++ Response 404\n\
+";
+    
+    // Parsed by a parser and a context of its own
+    Parser referenceParser;
+    Result referenceResult;
+    Blueprint referenceBlueprint;
+    referenceParser.parse(blueprintSource, 0, referenceResult, referenceBlueprint);
+    
+    Parser parser;
+    ParserContext context;
+    for (int i = 0; i < 3; ++i) {
+        Result result;
+        Blueprint blueprint;
+        parser.parse(blueprintSource, 0, result, blueprint, context);
+        RequireSameResult(result, referenceResult);
+        RequireSameBlueprint(blueprint, referenceBlueprint);
+        
+        // Failed parse in between does not affect the next one
+        Result errorResult;
+        Blueprint errorBlueprint;
+        parser.parse("hello\t", 0, errorResult, errorBlueprint, context);
+        REQUIRE(errorResult.error.code != Error::OK);
+    }
+}
+
 TEST_CASE("Parse bluprint with unsupported characters", "[parser]")
 {
     Parser parser;
@@ -325,3 +472,35 @@ TEST_CASE("SIGTERM parsing blueprint", "[parser][issue][#45]")
     REQUIRE(result.warnings.size() == 4);
 }
 
+
+TEST_CASE("Validate blueprint reporting the same result as parsing", "[parser][validate]")
+{
+    const char* blueprintSources[] = {
+        "# API\nDescription\n\n# Group G\n> quote\n\n# /r\n+ Model (text/plain)\n\n        M\n\n## GET\n+ Response 200\n\n        [/r][]\n\n"\
+        "## POST\n+ Request\n    + Headers\n\n            Content-Length: 10\n\n+ Response 204\n\n        Body\n\n",
+        "# GET /1\n+ response 200\n+ list\n",
+        "# A\n# B\nC\n\nD\n\nE\n\nF\n\nG\n\n# /1\n# GET\n+ Request\n+ Response 200\n    + Body\n\n            H\n\nI\n# J\n> K",
+        "# GET /1\n+ Response 200\n    + Body\n\n            A\n\n    + Body\n\n            B\n\n+ Response\n\n        [Undefined][]\n"
+    };
+    
+    Parser parser;
+    for (size_t i = 0; i < sizeof(blueprintSources) / sizeof(blueprintSources[0]); ++i) {
+        Result result;
+        Blueprint blueprint;
+        parser.parse(blueprintSources[i], 0, result, blueprint);
+        
+        Result validateResult;
+        Blueprint validateBlueprint;
+        parser.parse(blueprintSources[i], ValidateOnlyOption, validateResult, validateBlueprint);
+        
+        REQUIRE(validateResult.error.code == result.error.code);
+        REQUIRE(validateResult.error.message == result.error.message);
+        REQUIRE(validateResult.warnings.size() == result.warnings.size());
+        for (size_t w = 0; w < result.warnings.size(); ++w) {
+            REQUIRE(validateResult.warnings[w].code == result.warnings[w].code);
+            REQUIRE(validateResult.warnings[w].message == result.warnings[w].message);
+        }
+        
+        REQUIRE(validateBlueprint.description.empty());
+    }
+}
@@ -6,6 +6,7 @@
 //  Copyright (c) 2013 Apiary Inc. All rights reserved.
 //
 
+#include <sstream>
 #include "catch.hpp"
 #include "RegexMatch.h"
 
@@ -33,3 +34,69 @@ TEST_CASE("regexmatch/request-payload", "Match request payload test")
 {
     REQUIRE(RegexMatch("Request My Id (application/json)", "^[Rr]equest([[:space:]]+([A-Za-z0-9_]|[[:space:]])*)?([[:space:]]\\([^\\)]*\\))?$") == true);
 }
+
+TEST_CASE("regexmatch/cache", "Compiled expressions are cached")
+{
+    ResetRegexCache();
+    
+    REQUIRE(RegexMatch("The quick brown fox jumps over the lazy dog", "fox[[:space:]]") == true);
+    RegexCacheStatistics statistics = GetRegexCacheStatistics();
+    REQUIRE(statistics.misses == 1);
+    REQUIRE(statistics.compiles == 1);
+    REQUIRE(statistics.hits == 0);
+    REQUIRE(statistics.size == 1);
+    
+    CaptureGroups groups;
+    REQUIRE(RegexMatch("The quick brown fox jumps over the lazy dog", "fox[[:space:]]") == true);
+    REQUIRE(RegexCapture("The quick brown fox jumps over the lazy dog", "fox[[:space:]]", groups) == true);
+    REQUIRE(groups[0] == "fox ");
+    
+    statistics = GetRegexCacheStatistics();
+    REQUIRE(statistics.misses == 1);
+    REQUIRE(statistics.compiles == 1);
+    REQUIRE(statistics.hits == 2);
+    REQUIRE(statistics.size == 1);
+}
+
+TEST_CASE("regexmatch/cache-bounds", "Regex cache holds a limited number of expressions")
+{
+    ResetRegexCache();
+    
+    for (size_t i = 0; i <= RegexCacheCapacity; ++i) {
+        std::stringstream ss;
+        ss << "^a{" << i << "}$";
+        RegexMatch("a", ss.str());
+    }
+    
+    RegexCacheStatistics statistics = GetRegexCacheStatistics();
+    REQUIRE(statistics.compiles == RegexCacheCapacity + 1);
+    REQUIRE(statistics.evictions == 1);
+    REQUIRE(statistics.size == RegexCacheCapacity);
+    
+    // Least recently used expression is gone
+    RegexMatch("a", "^a{0}$");
+    statistics = GetRegexCacheStatistics();
+    REQUIRE(statistics.hits == 0);
+    REQUIRE(statistics.compiles == RegexCacheCapacity + 2);
+}
+
+TEST_CASE("regexmatch/capture-ranges", "Capture byte ranges of groups")
+{
+    std::string target = "Request Create Note (application/json)";
+    CaptureRanges ranges;
+    
+    REQUIRE(RegexCaptureRanges(target, "^Request( [^(]+)?( \\(([^)]*)\\))?(X)?$", ranges, 5) == true);
+    REQUIRE(ranges.size == 5);
+    REQUIRE(ranges[0].location == 0);
+    REQUIRE(ranges[0].length == target.length());
+    REQUIRE(CaptureRangeString(target, ranges[1]) == " Create Note");
+    REQUIRE(ranges[3].location == 21);
+    REQUIRE(CaptureRangeString(target, ranges[3]) == "application/json");
+    
+    // Unmatched group
+    REQUIRE(ranges[4].length == 0);
+    REQUIRE(CaptureRangeString(target, ranges[4]).empty());
+    
+    REQUIRE(RegexCaptureRanges(target, "^Response", ranges) == false);
+    REQUIRE(ranges.size == 0);
+}
@@ -0,0 +1,255 @@
+//
+//  test-SignatureLexer.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include <string>
+#include <vector>
+#include "catch.hpp"
+#include "SignatureLexer.h"
+#include "ResourceGroupParser.h"
+#include "AssetParser.h"
+
+using namespace snowcrash;
+
+/** Signature lexer under test */
+enum LexedSignature {
+    GroupHeaderLexed = 0,
+    ResourceHeaderLexed,
+    NamedResourceHeaderLexed,
+    ActionHeaderLexed,
+    NamedActionHeaderLexed,
+    RequestLexed,
+    ResponseLexed,
+    ObjectLexed,
+    ModelLexed,
+    HeadersLexed,
+    ParametersLexed,
+    BodyLexed,
+    SchemaLexed,
+    ValuesLexed,
+    LexedSignatureCount
+};
+
+/** Run the lexer of given kind, tokens are returned in first and second */
+static bool Lex(LexedSignature kind, const std::string& source, SignatureToken& first, SignatureToken& second)
+{
+    switch (kind) {
+        case GroupHeaderLexed:
+            second.location = second.length = 0;
+            return LexResourceGroupHeader(source, first);
+        case ResourceHeaderLexed:
+            return LexResourceHeader(source, first, second);
+        case NamedResourceHeaderLexed:
+            return LexNamedResourceHeader(source, first, second);
+        case ActionHeaderLexed:
+            return LexActionHeader(source, first, second);
+        case NamedActionHeaderLexed:
+            return LexNamedActionHeader(source, first, second);
+        case RequestLexed:
+            return LexRequestSignature(source, first, second);
+        case ResponseLexed:
+            return LexResponseSignature(source, first, second);
+        case ObjectLexed:
+            return LexObjectSignature(source, first, second);
+        case ModelLexed:
+            return LexModelSignature(source, first, second);
+        case HeadersLexed:
+            return LexKeywordSignature(source, "header", true);
+        case ParametersLexed:
+            return LexKeywordSignature(source, "parameter", true);
+        case BodyLexed:
+            return LexKeywordSignature(source, "body");
+        case SchemaLexed:
+            return LexKeywordSignature(source, "schema");
+        case ValuesLexed:
+            return LexKeywordSignature(source, "values");
+        default:
+            return false;
+    }
+}
+
+/** Reference expression and its capture groups corresponding to the lexer tokens */
+static void Reference(LexedSignature kind, std::string& regex, int& first, int& second)
+{
+    first = second = -1;
+    switch (kind) {
+        case GroupHeaderLexed:
+            regex = snowcrashconst::GroupHeaderRegex; first = 1;
+            break;
+        case ResourceHeaderLexed:
+            regex = snowcrashconst::ResourceHeaderRegex; first = 2; second = 3;
+            break;
+        case NamedResourceHeaderLexed:
+            regex = snowcrashconst::NamedResourceHeaderRegex; first = 1; second = 2;
+            break;
+        case ActionHeaderLexed:
+            regex = snowcrashconst::ActionHeaderRegex; first = 1; second = 2;
+            break;
+        case NamedActionHeaderLexed:
+            regex = snowcrashconst::NamedActionHeaderRegex; first = 1; second = 2;
+            break;
+        case RequestLexed:
+            regex = snowcrashconst::RequestRegex; first = 1; second = 3;
+            break;
+        case ResponseLexed:
+            regex = snowcrashconst::ResponseRegex; first = 1; second = 3;
+            break;
+        case ObjectLexed:
+            regex = snowcrashconst::ObjectRegex; first = 1; second = 3;
+            break;
+        case ModelLexed:
+            regex = snowcrashconst::ModelRegex; first = 1; second = 3;
+            break;
+        case HeadersLexed:
+            regex = snowcrashconst::HeadersRegex;
+            break;
+        case ParametersLexed:
+            regex = snowcrashconst::ParametersRegex;
+            break;
+        case BodyLexed:
+            regex = snowcrashconst::BodyRegex;
+            break;
+        case SchemaLexed:
+            regex = snowcrashconst::SchemaRegex;
+            break;
+        case ValuesLexed:
+            regex = snowcrashconst::ParameterValuesRegex;
+            break;
+        default:
+            break;
+    }
+}
+
+/** Check the lexer gives the very same result as its regex counterpart */
+static void CheckAgainstRegex(const std::string& source)
+{
+    for (int i = 0; i < LexedSignatureCount; ++i) {
+        LexedSignature kind = static_cast<LexedSignature>(i);
+
+        std::string regex;
+        int first, second;
+        Reference(kind, regex, first, second);
+
+        CaptureGroups captureGroups;
+        bool expected = RegexCapture(source, regex, captureGroups, 5);
+
+        SignatureToken firstToken, secondToken;
+        bool lexed = Lex(kind, source, firstToken, secondToken);
+
+        INFO("source: '" << source << "' regex: " << regex);
+        REQUIRE(lexed == expected);
+
+        if (!expected)
+            continue;
+
+        if (first != -1)
+            REQUIRE(SignatureTokenString(source, firstToken) == captureGroups[first]);
+
+        if (second != -1)
+            REQUIRE(SignatureTokenString(source, secondToken) == captureGroups[second]);
+    }
+}
+
+/** Check payload dispatch gives the same result as trying payload regexes in order */
+static void CheckPayloadAgainstRegex(const std::string& source)
+{
+    const char* regexes[] = {
+        snowcrashconst::RequestRegex,
+        snowcrashconst::ResponseRegex,
+        snowcrashconst::ObjectRegex,
+        snowcrashconst::ModelRegex
+    };
+
+    CaptureGroups captureGroups;
+    int expected = NoPayloadKeyword;
+    for (int i = 0; i < 4 && expected == NoPayloadKeyword; ++i) {
+        if (RegexCapture(source, regexes[i], captureGroups, 5))
+            expected = RequestPayloadKeyword + i;
+    }
+
+    SignatureToken name, mediaType;
+    PayloadKeyword keyword = LexPayloadSignature(source, name, mediaType);
+
+    INFO("source: '" << source << "'");
+    REQUIRE(keyword == expected);
+
+    if (keyword != NoPayloadKeyword) {
+        REQUIRE(SignatureTokenString(source, name) == captureGroups[1]);
+        REQUIRE(SignatureTokenString(source, mediaType) == captureGroups[3]);
+    }
+}
+
+TEST_CASE("signaturelexer/tokens", "Lexing a signature yields its tokens")
+{
+    SignatureToken name, uri, method, mediaType;
+    std::string source = "My Resource [/resource/{id}]";
+
+    REQUIRE(LexNamedResourceHeader(source, name, uri));
+    REQUIRE(SignatureTokenString(source, name) == "My Resource");
+    REQUIRE(SignatureTokenString(source, uri) == "/resource/{id}");
+    REQUIRE_FALSE(LexResourceHeader(source, method, uri));
+
+    source = "GET /resource";
+    REQUIRE(LexResourceHeader(source, method, uri));
+    REQUIRE(SignatureTokenString(source, method) == "GET");
+    REQUIRE(SignatureTokenString(source, uri) == "/resource");
+
+    source = "Response 200 (application/json)";
+    REQUIRE(LexResponseSignature(source, name, mediaType));
+    REQUIRE(SignatureTokenString(source, name) == " 200 ");
+    REQUIRE(SignatureTokenString(source, mediaType) == "application/json");
+    REQUIRE_FALSE(LexRequestSignature(source, name, mediaType));
+
+    source = "Note Model";
+    REQUIRE(LexModelSignature(source, name, mediaType));
+    REQUIRE(SignatureTokenString(source, name) == "Note ");
+    REQUIRE(mediaType.length == 0);
+
+    REQUIRE(LexKeywordSignature(" Headers ", "header", true));
+    REQUIRE(LexKeywordSignature("header", "header", true));
+    REQUIRE_FALSE(LexKeywordSignature("headerss", "header", true));
+    REQUIRE_FALSE(LexKeywordSignature("Bodies", "body"));
+}
+
+TEST_CASE("signaturelexer/regex-differential", "Signature lexer agrees with regular expressions")
+{
+    // Fragments of section headers and their tricky variations
+    const char* fragments[] = {
+        "", " ", "\t", "Group", "group", "Resource", "Request", "request", "Response",
+        "Object", "object", "Model", "model", "Headers", "header", "Parameters", "Body",
+        "Schema", "Values", "values", "s", "GET", "POST", "PROPPATCH", "UNLINK", "GETX",
+        "/", "/resource/{id}", "[", "]", "(", ")", "\\", "(application/json)",
+        "(text\\plain)", "[GET]", "[/notes]", " 200", "404 ", "My Name", "\n"
+    };
+
+    const size_t count = sizeof(fragments) / sizeof(fragments[0]);
+
+    std::vector<std::string> sources;
+    sources.push_back("# Group Notes");
+    sources.push_back("Notes Collection [/notes{?limit}]");
+    sources.push_back("Create a Note [POST]");
+    sources.push_back("Request Create Note (application/json) ");
+    sources.push_back(" Response 201 (application/json)");
+    sources.push_back("Note Object (text/plain)");
+    sources.push_back("Note Model (application/json)");
+    sources.push_back("Model(application/json)(text/plain)");
+    sources.push_back("Model Model Model");
+    sources.push_back("Group  ");
+    sources.push_back("   [/]");
+    sources.push_back("Object object");
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            sources.push_back(std::string(fragments[i]) + fragments[j]);
+            sources.push_back(std::string(fragments[i]) + " " + fragments[j]);
+        }
+    }
+
+    for (std::vector<std::string>::const_iterator it = sources.begin(); it != sources.end(); ++it) {
+        CheckAgainstRegex(*it);
+        CheckPayloadAgainstRegex(*it);
+    }
+}
@@ -0,0 +1,61 @@
+//
+//  test-SignatureMemo.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include "catch.hpp"
+#include "Fixture.h"
+#include "SignatureMemo.h"
+#include "ResourceGroupParser.h"
+
+using namespace snowcrash;
+using namespace snowcrashtest;
+
+TEST_CASE("signaturememo/scope", "Signatures are classified once per active memo")
+{
+    // # GET /resource
+    // + Response 200
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /resource", 1, MakeSourceDataBlock(0, 16)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200", 0, MakeSourceDataBlock(16, 15)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, SourceDataBlock()));
+
+    const MarkdownBlock::Stack& blocks = markdown;
+    ResetSignatureMemoStatistics();
+
+    // No memo active
+    REQUIRE(HasActionSignature(blocks.front()));
+    REQUIRE(HasActionSignature(blocks.front()));
+    REQUIRE(GetSignatureMemoStatistics().lookups == 0);
+
+    {
+        SignatureMemo memo;
+        SignatureMemo::Scope scope(memo, blocks);
+
+        REQUIRE(HasActionSignature(blocks.front()));
+        REQUIRE(HasActionSignature(blocks.front()));
+        REQUIRE_FALSE(HasResourceGroupSignature(blocks.front()));
+
+        BlockIterator list = blocks.begin() + 1;
+        REQUIRE(QueryPayloadSignature(list, blocks.end()) == ResponsePayloadSignature);
+        REQUIRE(QueryPayloadSignature(list, blocks.end()) == ResponsePayloadSignature);
+        REQUIRE(HasPayloadSignature(list, blocks.end()));
+
+        SignatureMemoStatistics statistics = GetSignatureMemoStatistics();
+        REQUIRE(statistics.lookups == 6);
+        REQUIRE(statistics.hits == 3);
+        REQUIRE(statistics.stores == 3);
+
+        // Blocks outside of the bound stack are not memoized
+        MarkdownBlock header(HeaderBlockType, "GET /resource");
+        REQUIRE(HasActionSignature(header));
+        REQUIRE(GetSignatureMemoStatistics().lookups == 6);
+    }
+
+    REQUIRE(HasActionSignature(blocks.front()));
+    REQUIRE(GetSignatureMemoStatistics().lookups == 6);
+}
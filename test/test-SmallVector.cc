@@ -0,0 +1,148 @@
+//
+//  test-SmallVector.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include "catch.hpp"
+#include "ParserCore.h"
+
+using namespace snowcrash;
+
+TEST_CASE("smallvector/inline", "Small vector holds elements inline up to its capacity")
+{
+    SmallVector<int, 2> v;
+    REQUIRE(v.empty());
+    REQUIRE(v.isInline());
+    REQUIRE(v.capacity() == 2);
+
+    v.push_back(1);
+    v.push_back(2);
+    REQUIRE(v.isInline());
+    REQUIRE(v.size() == 2);
+
+    v.push_back(3);
+    REQUIRE(!v.isInline());
+    REQUIRE(v.size() == 3);
+    REQUIRE(v.front() == 1);
+    REQUIRE(v.back() == 3);
+
+    v.insert(v.begin() + 1, 4);
+    REQUIRE(v.size() == 4);
+    REQUIRE(v[1] == 4);
+    REQUIRE(v[2] == 2);
+
+    v.erase(v.begin());
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[0] == 4);
+
+    SmallVector<int, 2> copy(v);
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy[2] == 3);
+
+    SmallVector<int, 2> small(1, 5);
+    small.swap(copy);
+    REQUIRE(small.size() == 3);
+    REQUIRE(small[0] == 4);
+    REQUIRE(copy.size() == 1);
+    REQUIRE(copy[0] == 5);
+    REQUIRE(copy.isInline());
+
+    // Swap vectors holding their elements inline
+    SmallVector<int, 2> one(1, 8);
+    SmallVector<int, 2> two(2, 9);
+    one.swap(two);
+    REQUIRE(one.size() == 2);
+    REQUIRE(one[1] == 9);
+    REQUIRE(two.size() == 1);
+    REQUIRE(two[0] == 8);
+
+    // Push an element of the vector itself while growing
+    SmallVector<int, 2> self(2, 7);
+    self.push_back(self[0]);
+    REQUIRE(self.size() == 3);
+    REQUIRE(self[2] == 7);
+}
+
+namespace {
+
+    // Element counting the copies of slots no element was stored in
+    struct Slot {
+        static int unusedCopies;
+
+        Slot() : value(-1) {}
+        Slot(int v) : value(v) {}
+        Slot(const Slot& rhs) : value(rhs.value) { count(rhs); }
+        Slot& operator=(const Slot& rhs) { count(rhs); value = rhs.value; return *this; }
+
+        int value;
+
+        static void count(const Slot& rhs) {
+            if (rhs.value == -1)
+                ++unusedCopies;
+        }
+    };
+
+    int Slot::unusedCopies = 0;
+}
+
+TEST_CASE("smallvector/swap-inline", "Swap inline vectors of different lengths copying only the elements in use")
+{
+    SmallVector<Slot, 4> shorter(1, Slot(1));
+    SmallVector<Slot, 4> longer;
+    longer.push_back(Slot(2));
+    longer.push_back(Slot(3));
+    longer.push_back(Slot(4));
+
+    Slot::unusedCopies = 0;
+    shorter.swap(longer);
+    REQUIRE(Slot::unusedCopies == 0);
+
+    REQUIRE(shorter.isInline());
+    REQUIRE(shorter.size() == 3);
+    REQUIRE(shorter[0].value == 2);
+    REQUIRE(shorter[1].value == 3);
+    REQUIRE(shorter[2].value == 4);
+
+    REQUIRE(longer.isInline());
+    REQUIRE(longer.size() == 1);
+    REQUIRE(longer[0].value == 1);
+
+    // And back, the longer vector being the left one
+    shorter.swap(longer);
+    REQUIRE(Slot::unusedCopies == 0);
+    REQUIRE(shorter.size() == 1);
+    REQUIRE(shorter[0].value == 1);
+    REQUIRE(longer.size() == 3);
+    REQUIRE(longer[2].value == 4);
+}
+
+TEST_CASE("smallvector/sourceblock", "Source data blocks are appended and split")
+{
+    SourceDataBlock block = MakeSourceDataBlock(0, 2);
+    REQUIRE(block.isInline());
+
+    SourceDataBlock append = MakeSourceDataBlock(2, 3);
+    SourceDataRange range = {10, 4};
+    append.push_back(range);
+    range.location = 20;
+    append.push_back(range);
+
+    AppendSourceDataBlock(block, append);
+    REQUIRE(block.size() == 3);
+    REQUIRE(block[0].location == 0);
+    REQUIRE(block[0].length == 5);
+    REQUIRE(block[1].location == 10);
+    REQUIRE(block[2].location == 20);
+
+    SourceDataBlockPair split = SplitSourceDataBlock(block, 7);
+    REQUIRE(split.first.size() == 2);
+    REQUIRE(split.first[1].location == 10);
+    REQUIRE(split.first[1].length == 2);
+    REQUIRE(split.second.size() == 2);
+    REQUIRE(split.second[0].location == 12);
+    REQUIRE(split.second[0].length == 2);
+    REQUIRE(split.first.isInline());
+    REQUIRE(split.second.isInline());
+}
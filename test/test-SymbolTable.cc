@@ -10,6 +10,7 @@
 #include "catch.hpp"
 #include "ResourceParser.h"
 #include "ResourceGroupParser.h"
+#include "BlueprintParser.h"
 #include "Fixture.h"
 
 using namespace snowcrash;
@@ -38,3 +39,95 @@ TEST_CASE("symbol/resource-object", "Parse object resource symbol")
     ParseSectionResult result2 = ResourceParser::Parse(markdown.begin(), markdown.end(), rootSection, parser2, resource2);
     REQUIRE(result2.first.error.code != Error::OK);
 }
+
+TEST_CASE("symbol/key", "Symbol names are normalized")
+{
+    SymbolKey key(" My Resource\t");
+    REQUIRE(key.name == "My Resource");
+    REQUIRE(key == SymbolKey("My Resource"));
+    REQUIRE(key.hash == SymbolKeyHash()(SymbolKey("My Resource")));
+    REQUIRE(!(key == SymbolKey("My resource")));
+    
+    ResourceModelSymbolTable resourceModels;
+    resourceModels["My Resource"].body = "X.O.";
+    REQUIRE(resourceModels.find(" My Resource ") != resourceModels.end());
+    
+    // Already trimmed name
+    SymbolKey normalized = SymbolKey::Normalized("My Resource");
+    REQUIRE(normalized == key);
+    REQUIRE(resourceModels.find(normalized) != resourceModels.end());
+}
+
+TEST_CASE("symbol/hash", "FNV-1a hash of the size of size_t")
+{
+    if (sizeof(size_t) == 8) {
+        REQUIRE(HashString(NULL, 0) == static_cast<size_t>(14695981039346656037ull));
+        REQUIRE(HashString("a", 1) == static_cast<size_t>(0xaf63dc4c8601ec8cull));
+    }
+    else {
+        REQUIRE(HashString(NULL, 0) == static_cast<size_t>(2166136261ull));
+        REQUIRE(HashString("a", 1) == static_cast<size_t>(0xe40c292cull));
+    }
+}
+
+TEST_CASE("symbol/index", "Index the definitions and references of the models")
+{
+    // Blueprint in question:
+    //R"(
+    //# GET /b
+    //+ Response 200
+    //    [My Resource][]
+    //
+    // <see CanonicalResourceFixture()>
+    //
+    //# GET /c
+    //+ Response 200
+    //    [My Resource][]
+    //");
+    
+    MarkdownBlock::Stack markdown;
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /b", 1, MakeSourceDataBlock(0, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(1, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(2, 1)));
+    
+    MarkdownBlock::Stack resource = CanonicalResourceFixture();
+    markdown.insert(markdown.end(), resource.begin(), resource.end());
+    
+    markdown.push_back(MarkdownBlock(HeaderBlockType, "GET /c", 1, MakeSourceDataBlock(10, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockBeginType, SourceData(), 0, SourceDataBlock()));
+    markdown.push_back(MarkdownBlock(ListItemBlockEndType, "Response 200\n  [My Resource][]", 0, MakeSourceDataBlock(11, 1)));
+    markdown.push_back(MarkdownBlock(ListBlockEndType, SourceData(), 0, MakeSourceDataBlock(12, 1)));
+    
+    Result result;
+    Blueprint blueprint;
+    SymbolIndex symbolIndex;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, result, blueprint, NULL, NULL, ParserBudget(), &symbolIndex);
+    
+    REQUIRE(result.error.code == Error::OK);
+    REQUIRE(symbolIndex.size() == 1);
+    
+    SymbolIndex::const_iterator it = symbolIndex.find("My Resource");
+    REQUIRE(it != symbolIndex.end());
+    REQUIRE(it->second.definition.size() == 1);
+    REQUIRE(it->second.definition[0].location == 2);
+    REQUIRE(it->second.referenceCount() == 2);
+    REQUIRE(it->second.references[0].size() == 1);
+    REQUIRE(it->second.references[0][0].location == 1);
+    REQUIRE(it->second.references[1][0].location == 11);
+    
+    // Model never referred
+    markdown.erase(markdown.begin(), markdown.begin() + 5);
+    markdown.erase(markdown.end() - 5, markdown.end());
+    
+    Result unusedResult;
+    Blueprint unusedBlueprint;
+    BlueprintParser::Parse(SourceDataFixture, markdown, 0, unusedResult, unusedBlueprint, NULL, NULL, ParserBudget(), &symbolIndex);
+    
+    REQUIRE(unusedResult.error.code == Error::OK);
+    REQUIRE(symbolIndex.size() == 1);
+    REQUIRE(symbolIndex["My Resource"].referenceCount() == 0);
+    REQUIRE(!symbolIndex["My Resource"].definition.empty());
+}
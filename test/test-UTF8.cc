@@ -0,0 +1,91 @@
+//
+//  test-UTF8.cc
+//  snowcrash
+//
+//  Created by agent on 10/16/26.
+//
+
+#include <cstdlib>
+#include <string>
+#include "catch.hpp"
+#include "UTF8.h"
+
+using namespace snowcrash;
+
+/** Kernels to test */
+static const UTF8CountKernel Kernels[] = { ScalarUTF8CountKernel, SSE2UTF8CountKernel, AVX2UTF8CountKernel };
+static const size_t KernelCount = sizeof(Kernels) / sizeof(Kernels[0]);
+
+/** Reference count, decoding lead bytes */
+static size_t CountReference(const std::string& data, size_t begin, size_t end)
+{
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        unsigned char byte = static_cast<unsigned char>(data[i]);
+        if (byte < 0x80 || byte >= 0xC0)
+            ++count;
+    }
+
+    return count;
+}
+
+/** Require all kernels to agree with the reference at every offset and length up to a limit */
+static void RequireKernelsCount(const std::string& data, size_t limit)
+{
+    for (size_t begin = 0; begin < 40 && begin < data.length(); ++begin) {
+        for (size_t end = begin; end <= data.length() && end - begin <= limit; end += 1 + (end - begin) / 16) {
+            size_t expected = CountReference(data, begin, end);
+
+            for (size_t k = 0; k < KernelCount; ++k)
+                REQUIRE(CountUTF8Characters(data.data() + begin, end - begin, Kernels[k]) == expected);
+
+            REQUIRE(CountUTF8Characters(data.data() + begin, end - begin) == expected);
+        }
+    }
+}
+
+TEST_CASE("utf8/count", "Count characters of a valid UTF-8 text")
+{
+    std::string text = "Příliš žluťoučký kůň úpěl ďábelské ódy. 中文 ";
+    REQUIRE(CountUTF8Characters(text.data(), text.length()) == 43);
+    REQUIRE(CountUTF8Characters(NULL, 10) == 0);
+    REQUIRE(CountUTF8Characters(text.data(), 0) == 0);
+
+    std::string repeated;
+    for (size_t i = 0; i < 200; ++i)
+        repeated += text;
+
+    RequireKernelsCount(repeated, 600);
+
+    for (size_t k = 0; k < KernelCount; ++k)
+        REQUIRE(CountUTF8Characters(repeated.data(), repeated.length(), Kernels[k]) == 43 * 200);
+
+    REQUIRE(IsUTF8CountKernelSupported(ScalarUTF8CountKernel));
+    REQUIRE(IsUTF8CountKernelSupported(GetUTF8CountKernel()));
+}
+
+TEST_CASE("utf8/count-adversarial", "Count characters of random and malformed UTF-8")
+{
+    ::srand(42);
+
+    std::string random;
+    for (size_t i = 0; i < 4096; ++i)
+        random += static_cast<char>(::rand() & 0xFF);
+
+    RequireKernelsCount(random, 300);
+
+    // Overflow of the vector lane accumulators
+    const char* patterns[] = { "\x80", "\xBF", "\xC0", "\xFF", "\x7F", "\0", "\xE2\x82\xAC" };
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p) {
+        std::string pattern = (patterns[p][0]) ? std::string(patterns[p]) : std::string(1, '\0');
+        std::string data;
+        while (data.length() < 100000)
+            data += pattern;
+
+        size_t expected = CountReference(data, 0, data.length());
+        for (size_t k = 0; k < KernelCount; ++k) {
+            REQUIRE(CountUTF8Characters(data.data(), data.length(), Kernels[k]) == expected);
+            REQUIRE(CountUTF8Characters(data.data() + 1, data.length() - 1, Kernels[k]) == CountReference(data, 1, data.length()));
+        }
+    }
+}